@@ -0,0 +1,96 @@
+#include <tartan/board/attacks.hpp>
+
+namespace tt {
+
+namespace {
+
+// Magic multipliers of every tile, found offline with a sparse
+// random search for the masks and shifts computed below
+constexpr Bitboard bishopMagicNumbers[64] = {
+	0x0002041000820080ULL, 0x02A0020403549122ULL, 0x0010408081009424ULL, 0x2208068100004214ULL,
+	0x0014042212002000ULL, 0x20809004201820A0ULL, 0x0410880109200210ULL, 0x0001C50050100480ULL,
+	0x4000C09042008102ULL, 0x2303300542118200ULL, 0x910008080B01312CULL, 0x02000820822008A3ULL,
+	0x0220220210000000ULL, 0x800A090908408200ULL, 0x0004408808039000ULL, 0x440000CC040426C0ULL,
+	0x90103020A0810108ULL, 0x0020041C94044042ULL, 0x0144000208020108ULL, 0x00080C0222004024ULL,
+	0x0002001016100804ULL, 0x004A001040500442ULL, 0x1010808114100209ULL, 0x2084200202220200ULL,
+	0x2DA0040108108400ULL, 0x8110020011041104ULL, 0x0008110002020200ULL, 0x3004080081010500ULL,
+	0x0010101081004000ULL, 0x0402002082009040ULL, 0x0001060004580441ULL, 0x4010802201010800ULL,
+	0x1424208800045062ULL, 0x0014100880220200ULL, 0x0090202420080800ULL, 0x2008620084080080ULL,
+	0x0108220400001100ULL, 0x0020080020004404ULL, 0x1141281080820200ULL, 0x00050A6080010410ULL,
+	0x2001484606404020ULL, 0x240041101008C800ULL, 0x2002021404100200ULL, 0x0086002018014100ULL,
+	0x2102102010480200ULL, 0x0050602080221100ULL, 0x0004044C44420C08ULL, 0x1102040862004084ULL,
+	0x080100A820080020ULL, 0x0A2100580404000AULL, 0x022000221110000AULL, 0x84000028420228A8ULL,
+	0x0910000410442014ULL, 0x00044A5010008200ULL, 0x0040040410CA1001ULL, 0x0021020082088024ULL,
+	0x0009804402414008ULL, 0x0100062C16082410ULL, 0x2380880100A80402ULL, 0x02202800002A0800ULL,
+	0x1800C01004050400ULL, 0x0100030820640420ULL, 0x0104200401023400ULL, 0x0045A00802002040ULL,
+};
+constexpr Bitboard rookMagicNumbers[64] = {
+	0x0080102080004000ULL, 0x04C0084010002000ULL, 0x0100104020010008ULL, 0x0100100008200500ULL,
+	0x4100080011000402ULL, 0x0900010082040008ULL, 0x2200240522881A00ULL, 0x018000408000A300ULL,
+	0x2706002042008104ULL, 0x0082004081002200ULL, 0x4010801000802000ULL, 0x0202804800100082ULL,
+	0x0820800800800400ULL, 0x0841000204008900ULL, 0x0915000100020004ULL, 0x0049000042308100ULL,
+	0x8008208008400080ULL, 0x0010004000402000ULL, 0x0110010100402000ULL, 0x2200808010000801ULL,
+	0xD000050008001100ULL, 0x7046008004000280ULL, 0x1000840050082201ULL, 0x00100200040040B1ULL,
+	0x0880208080004018ULL, 0x0000410200208200ULL, 0x8030080020040020ULL, 0x0200200900100101ULL,
+	0x0008000880800400ULL, 0x0000020080040080ULL, 0x0001004100020044ULL, 0x0820804200010084ULL,
+	0x0280804008800020ULL, 0x0401804001802010ULL, 0x0002812002801000ULL, 0x0800100084800800ULL,
+	0x0250080080800400ULL, 0x400380C200800400ULL, 0x0A10011004000208ULL, 0x0C0008408A001401ULL,
+	0xA110209040008001ULL, 0x2890005020004000ULL, 0x0002C02001030010ULL, 0x0202004010220008ULL,
+	0x0000080100050010ULL, 0x0006000884420050ULL, 0x100C081001040002ULL, 0x1040804081220004ULL,
+	0x0040510020800100ULL, 0x5620008020401080ULL, 0x0010401200228600ULL, 0x13044020100A0200ULL,
+	0x0003100801000500ULL, 0x2204000201004040ULL, 0xA094908802010400ULL, 0x0008484304841200ULL,
+	0x4840104200810022ULL, 0x0001002040801202ULL, 0x0000902000890141ULL, 0x1811002008041001ULL,
+	0x804200105C200826ULL, 0x9001000400080201ULL, 0x00001000C1020804ULL, 0x1400093141008402ULL,
+};
+
+constexpr Direction bishopDirections[4] = {SouthWest, SouthEast, NorthEast, NorthWest};
+constexpr Direction rookDirections[4] = {South, West, North, East};
+
+Bitboard slidingAttacks(int sq, Bitboard occupancy, const Direction* dirs) {
+	Bitboard attacks = 0;
+	for (int i = 0; i < 4; i++) {
+		int x = squareX(sq), y = squareY(sq);
+		while (true) {
+			x += kingOffsets[dirs[i]][0];
+			y += kingOffsets[dirs[i]][1];
+			if (x < 1 or x > 8 or y < 1 or y > 8)
+				break;
+			attacks |= bit(square(x, y));
+			if (occupancy & bit(square(x, y)))
+				break;
+		}
+	}
+	return attacks;
+}
+
+void initMagics(Magic* magics, Bitboard* table, const Bitboard* numbers, const Direction* dirs) {
+	Bitboard* attacks = table;
+
+	for (int sq = 0; sq < 64; sq++) {
+		Bitboard edges =
+			((rank1 | rank8) & ~(rank1 << 8*(squareY(sq) - 1))) |
+			((fileA | fileH) & ~(fileA << (squareX(sq) - 1)));
+
+		Magic& m = magics[sq];
+		m.mask = slidingAttacks(sq, 0, dirs) & ~edges;
+		m.magic = numbers[sq];
+		m.shift = 64 - popcount(m.mask);
+		m.attacks = attacks;
+
+		Bitboard occupancy = 0;
+		do {
+			attacks[m.index(occupancy)] = slidingAttacks(sq, occupancy, dirs);
+			occupancy = (occupancy - m.mask) & m.mask;
+		} while (occupancy);
+		attacks += std::size_t(1) << popcount(m.mask);
+	}
+}
+
+}
+
+SlidingTables::SlidingTables() {
+	initMagics(bishopMagics, bishopTable, bishopMagicNumbers, bishopDirections);
+	initMagics(rookMagics, rookTable, rookMagicNumbers, rookDirections);
+}
+
+}
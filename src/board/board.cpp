@@ -2,8 +2,10 @@
 #include "tartan/board/exceptions.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <iostream>
 #include <ostream>
+#include <unordered_map>
 #include <vector>
 #include <initializer_list>
 
@@ -21,25 +23,9 @@ Board::Board(PieceSetT& s) : Board() {
 	fill(s);
 }
 
-template<class Iterator>
-Board::PieceSetT Board::set(Iterator begin, Iterator end) const {
-	PieceSetT pieces;
-	try {
-		while (begin != end) {
-			pieces.push_back(piece(*begin));
-			++begin;
-		}
-	} catch (ex::bad_piece_spec& ex) {
-		std::for_each(pieces.begin(), pieces.end(), 
-								[](Piece* p) { delete p; });
-		std::throw_with_nested(ex::bad_set());
-	}
+namespace {
 
-	return pieces;
-}
-
-
-Board::PieceSetT Board::set(const std::string& str) const {
+std::vector<std::string> tokens(const std::string& str) {
 	std::size_t start = 0, end = 0;
 
 	std::vector<std::string> tokens;
@@ -61,7 +47,36 @@ Board::PieceSetT Board::set(const std::string& str) const {
 	if (tokens.back().length() == 0)
 		tokens.pop_back();
 
-	return set(tokens.begin(), tokens.end());
+	return tokens;
+}
+
+}
+
+template<class Iterator>
+Board::PieceSetT Board::set(Iterator begin, Iterator end) const {
+	PieceSetT pieces;
+#ifndef TARTAN_NO_EXCEPTIONS
+	try {
+#endif
+		while (begin != end) {
+			pieces.push_back(piece(*begin));
+			++begin;
+		}
+#ifndef TARTAN_NO_EXCEPTIONS
+	} catch (ex::bad_piece_spec& ex) {
+		std::for_each(pieces.begin(), pieces.end(), 
+								[](Piece* p) { delete p; });
+		std::throw_with_nested(ex::bad_set());
+	}
+#endif
+
+	return pieces;
+}
+
+
+Board::PieceSetT Board::set(const std::string& str) const {
+	std::vector<std::string> specs = tokens(str);
+	return set(specs.begin(), specs.end());
 }
 
 TurnMap Board::possibleMoves(const Position& p) const {
@@ -70,48 +85,98 @@ TurnMap Board::possibleMoves(const Position& p) const {
 
 TurnMap Board::possibleMoves(const Piece* p) const {
 	if (p == nullptr)
-		throw ex::null_piece();
+		TARTAN_THROW(ex::null_piece());
 	if (p->board() != this)
-		throw ex::foreign_piece(p, this);
+		TARTAN_THROW(ex::foreign_piece(p, this));
 	TurnMap map = p->moveMap();
 	return map;
 };
 
-Piece* Board::canInsert(Piece* p) const {
+Status Board::checkInsert(const Piece* p) const {
 	if (p->board())
-		throw ex::foreign_piece(p, this);
+		return Status::ForeignPiece;
 
-	const Piece* const& dest = at(p->position());
-	if (dest)
-		throw ex::position_is_taken(p);
+	if (at(p->position()))
+		return Status::PositionIsTaken;
 
-	return p;
+	return Status::Ok;
+}
+
+Piece* Board::canInsert(Piece* p) const {
+	switch (Board::checkInsert(p)) {
+		case Status::ForeignPiece:
+			TARTAN_THROW(ex::foreign_piece(p, this));
+		case Status::PositionIsTaken:
+			TARTAN_THROW(ex::position_is_taken(p));
+		default:
+			return p;
+	}
 }
 
 Piece* Board::placePiece(Piece* p) {
 	at(p->position()) = p;
 	p->setBoard(this);
+	piecePlaced(p);
+	return p;
+}
+
+Piece* Board::removePiece(const Position& pos) {
+	Piece* p = at(pos);
+	if (!p)
+		TARTAN_THROW(ex::null_piece());
+
+	at(pos) = nullptr;
+	pieceRemoved(p);
 	return p;
 }
 
+void Board::piecePlaced(const Piece* p) {
+	const Position& pos = p->position();
+	int c = static_cast<int>(p->color());
+	b_occupancy[c] |= bit(square(pos.x(), pos.y()));
+	b_pieces[c].push_back(at(pos));
+}
+
+void Board::pieceRemoved(const Piece* p) {
+	const Position& pos = p->position();
+	int c = static_cast<int>(p->color());
+	b_occupancy[c] &= ~bit(square(pos.x(), pos.y()));
+	PieceListT& list = b_pieces[c];
+	list.erase(std::find(list.begin(), list.end(), p));
+}
+
+void Board::pieceMoved(const Piece* p, const Position& from) {
+	const Position& to = p->position();
+	b_occupancy[static_cast<int>(p->color())] ^= 
+		bit(square(from.x(), from.y())) | bit(square(to.x(), to.y()));
+}
+
 Piece* Board::insertPiece(Piece* p) {
 	return placePiece(
 		canInsert(p)
 	);
 }
 
-TurnMap Board::produceTurn(const Position& from, const Position& to, Turn** s) {
+Status Board::tryInsertPiece(Piece* p) {
+	Status s = checkInsert(p);
+	if (s == Status::Ok)
+		insertPiece(p);
+	return s;
+}
+
+Status Board::tryProduceTurn(const Position& from, const Position& to, 
+                             TurnMap& possible, Turn** s) {
 	Piece* turnpiece = at(from);
 	if (!turnpiece) 
-		throw ex::tile_is_empty(from, to);
+		return Status::TileIsEmpty;
 
 	if (turnpiece->color() != b_currentTurnColor)
-		throw ex::piece_in_wrong_color(turnpiece, to);
+		return Status::PieceInWrongColor;
 
-	TurnMap possible = possibleMoves(from);
+	possible = possibleMoves(from);
 
 	if (possible.empty())
-		throw ex::can_not_move(turnpiece, to);
+		return Status::CanNotMove;
 
 	TurnMap::iterator turn = find_if(
 		possible.begin(), 
@@ -122,18 +187,38 @@ TurnMap Board::produceTurn(const Position& from, const Position& to, Turn** s) {
 	);
 
 	if (turn == possible.end())
-		throw ex::no_such_move(turnpiece, to);
+		return Status::NoSuchMove;
 
 	*s = *turn;
-	return possible; 
+	return Status::Ok; 
+}
+
+TurnMap Board::produceTurn(const Position& from, const Position& to, Turn** s) {
+	TurnMap possible;
+	switch (tryProduceTurn(from, to, possible, s)) {
+		case Status::TileIsEmpty:
+			TARTAN_THROW(ex::tile_is_empty(from, to));
+		case Status::PieceInWrongColor:
+			TARTAN_THROW(ex::piece_in_wrong_color(at(from), to));
+		case Status::CanNotMove:
+			TARTAN_THROW(ex::can_not_move(at(from), to));
+		case Status::NoSuchMove:
+			TARTAN_THROW(ex::no_such_move(at(from), to));
+		default:
+			return possible;
+	}
 }
 
 const Turn* Board::applyTurn(Turn* t) {
-	b_history.push_back(t->clone());
 	if (t->capture())
-		b_capturedPieces.push_front(t->capture());
+		b_capturedPieces.push_back(t->capture());
 
 	t->apply();
+	b_history.push_back(t->clone());
+
+	for (auto& u : b_undone)
+		delete u;
+	b_undone.clear();
 
 	if (b_currentTurnColor == Color::White)
 		setCurrentTurn(Color::Black);
@@ -177,9 +262,45 @@ void Board::fill(std::initializer_list<const std::string> l) {
 	fill(l.begin(), l.end());
 }
 
+Status Board::tryFill(const std::string& str) {
+	PieceSetT pieces;
+	for (const std::string& spec : tokens(str)) {
+		Piece* p = tryPiece(spec);
+		if (!p) {
+			for (Piece* q : pieces)
+				delete q;
+			return Status::BadPieceSpec;
+		}
+		pieces.push_back(p);
+	}
+
+	Status s = Status::Ok;
+	for (Piece* p : pieces) {
+		if (s == Status::Ok)
+			s = tryInsertPiece(p);
+		if (s != Status::Ok)
+			delete p;
+	}
+	return s;
+}
+
+Piece* Board::tryPiece(const std::string& spec) const {
+#ifndef TARTAN_NO_EXCEPTIONS
+	try {
+		return piece(spec);
+	} catch (ex::bad_piece_spec&) {
+		return nullptr;
+	}
+#else
+	return piece(spec);
+#endif
+}
+
 void Board::clear() {
-	for (auto & p : board()) {
-		std::for_each(p.begin(), p.end(), [](Piece* p){ delete p; });
+	for (auto& list : b_pieces) {
+		for (Piece* p : list)
+			delete p;
+		list.clear();
 	}
 	for (auto& p : b_capturedPieces) {
 		delete p;
@@ -190,14 +311,92 @@ void Board::clear() {
 		delete t;
 	}
 	b_history.clear();
+	for (auto& t : b_undone) {
+		delete t;
+	}
+	b_undone.clear();
 
 	b_currentTurnColor = Piece::Color::White;
 	b_turnIndex = 0;
-
+	b_occupancy[0] = b_occupancy[1] = 0;
 
 	fillBoardWithNullptrs();
 }
 
+const Turn* Board::undoTurn() {
+	if (b_history.empty())
+		return nullptr;
+
+	Turn* t = const_cast<Turn*>(b_history.back());
+	b_history.pop_back();
+	t->undo();
+	if (t->capture())
+		restoreCaptured(t->capture());
+	b_undone.push_back(t);
+
+	setCurrentTurn(t->piece()->color());
+	return t;
+}
+
+const Turn* Board::redoTurn() {
+	if (b_undone.empty())
+		return nullptr;
+
+	Turn* t = const_cast<Turn*>(b_undone.back());
+	b_undone.pop_back();
+
+	// applyTurn() forgets the undone turns
+	HistoryT undone;
+	undone.swap(b_undone);
+	applyTurn(t);
+	undone.swap(b_undone);
+
+	delete t;
+	return b_history.back();
+}
+
+void Board::restoreCaptured(const Piece* p) {
+	auto it = std::find(b_capturedPieces.rbegin(), b_capturedPieces.rend(), p);
+	if (it != b_capturedPieces.rend())
+		b_capturedPieces.erase(std::next(it).base());
+}
+
+void Board::copyTo(Board& b, const PieceCopierT& copy, bool history) const {
+	std::unordered_map<const Piece*, Piece*> copies;
+	auto place = [&copy, &copies](const Piece* p) {
+		Piece* n = copy(p);
+		n->setBoard(nullptr);
+		copies[p] = n;
+		return n;
+	};
+
+	for (auto& list : b_pieces)
+		for (const Piece* p : list)
+			b.insertPiece(place(p));
+
+	if (history) {
+		for (const Piece* p : b_capturedPieces) {
+			Piece* n = place(p);
+			n->setBoard(&b);
+			b.b_capturedPieces.push_back(n);
+		}
+
+		auto find = [&copies](const Piece* p) -> Piece* {
+			auto it = copies.find(p);
+			return it == copies.end() ? nullptr : it->second;
+		};
+		for (const Turn* t : b_history) {
+			Turn* n = t->clone();
+			n->relink(find);
+			b.b_history.push_back(n);
+		}
+	}
+
+	b.b_turnIndex = b_turnIndex;
+	b.b_pieceGetter = b_pieceGetter;
+	b.setCurrentTurn(b_currentTurnColor);
+}
+
 void Board::fillBoardWithNullptrs() {
 	for (auto& row : board()) {
 		row.fill(nullptr);
@@ -207,7 +406,7 @@ void Board::fillBoardWithNullptrs() {
 Board::PieceTypesRetT Board::getPieceType(
 	Board::PieceTypesArgT types) {
 	if (!b_pieceGetter)
-		throw std::runtime_error("Piece getter is not set.");
+		TARTAN_THROW(std::runtime_error("Piece getter is not set."));
 
 	if (types.size() == 0)
 		return typeid(nullptr);
@@ -0,0 +1,293 @@
+#ifndef _TARTAN_BOARD_ATTACKS_HPP_
+#define _TARTAN_BOARD_ATTACKS_HPP_
+
+#include <tartan/board.hpp>
+#include <tartan/board/bitboard.hpp>
+
+#include <cstddef>
+#include <optional>
+
+#if defined(TARTAN_PEXT)
+#include <immintrin.h>
+#endif
+
+namespace tt {
+
+/**
+ * @brief Ray directions on the Board
+ *
+ * Values with the `Positive` bit set point to the
+ * bigger tile indices.
+ *
+ * @sa ray()
+ */
+enum Direction : int {
+	South = 0, West = 1, SouthWest = 2, SouthEast = 3,
+	North = 4, East = 5, NorthEast = 6, NorthWest = 7,
+	Positive = 4, //!< Set for directions that increase tile index
+};
+
+/**
+ * @brief Sliding piece attack table entry of a single tile
+ *
+ * Sliding attacks are precomputed for every relevant
+ * occupancy of every tile and looked up with a
+ * "magic" multiplication hash @cite chessProgrammingMagic
+ * or with the BMI2 `PEXT` instruction if the library is
+ * built with `TARTAN_PEXT` option.
+ *
+ * @sa SlidingTables, bishopAttacks(), rookAttacks()
+ */
+struct Magic {
+	//! Relevant occupancy tiles (board edges excluded)
+	Bitboard mask;
+	//! Magic multiplier
+	Bitboard magic;
+	//! Attacks of the tile indexed with index()
+	const Bitboard* attacks;
+	//! Right shift of the multiplication product
+	unsigned shift;
+	/**
+	 * @brief Attack table index of an occupancy
+	 *
+	 * @param occupancy occupied tiles
+	 * @return index into the attacks table
+	 */
+	unsigned index(Bitboard occupancy) const {
+#if defined(TARTAN_PEXT)
+		return static_cast<unsigned>(_pext_u64(occupancy, mask));
+#else
+		return static_cast<unsigned>(((occupancy & mask) * magic) >> shift);
+#endif
+	}
+};
+
+/**
+ * @brief Sliding piece attack tables
+ *
+ * Tables are filled from the magic multipliers found
+ * offline, which takes a few milliseconds. That is done
+ * on the first use through slidingTables(), so tables are
+ * never read before they are filled, even by the
+ * static initializers of other translation units.
+ */
+struct SlidingTables {
+	//! Construct and fill tables
+	SlidingTables();
+	SlidingTables(const SlidingTables&) = delete;
+	SlidingTables& operator=(const SlidingTables&) = delete;
+	//! Bishop Magic entries of every tile
+	Magic bishopMagics[64];
+	//! Rook Magic entries of every tile
+	Magic rookMagics[64];
+	//! Bishop attacks of every relevant occupancy of every tile
+	Bitboard bishopTable[0x1480];
+	//! Rook attacks of every relevant occupancy of every tile
+	Bitboard rookTable[0x19000];
+};
+
+/**
+ * @brief Sliding piece attack tables of the process
+ *
+ * @return tables, filled on the first call
+ */
+inline const SlidingTables& slidingTables() {
+	static const SlidingTables tables;
+	return tables;
+}
+
+/**
+ * @brief Leaper destinations of every tile
+ *
+ * Compile time table of the tiles reached from every 
+ * tile with a set of offsets, in the order of offsets. 
+ * Off-board destinations are left out, so the move
+ * generators walk the list without range checks.
+ *
+ * @tparam N count of offsets
+ */
+template<std::size_t N>
+struct Steps {
+	/**
+	 * @brief Construct new Steps table
+	 *
+	 * @param ofs (x, y) offsets
+	 */
+	constexpr Steps(const int (&ofs)[N][2]) {
+		for (int sq = 0; sq < 64; sq++) {
+			for (std::size_t i = 0; i < N; i++) {
+				std::optional<Square> t = Square(sq).tryOffset(ofs[i][0], ofs[i][1]);
+				if (t) {
+					to[sq][count[sq]++] = *t;
+					targets[sq] |= bit(t->index());
+				}
+			}
+		}
+	}
+	//! Count of destinations of every tile
+	std::uint8_t count[64] = {};
+	//! Destinations of every tile, first `count[tile]` are valid
+	Square to[64][N] = {};
+	//! Bitboard of destinations of every tile
+	Bitboard targets[64] = {};
+};
+
+//! Knight offsets
+constexpr int knightOffsets[8][2] = {
+	{1, 2}, {2, 1}, {2, -1}, {1, -2},
+	{-1, -2}, {-2, -1}, {-2, 1}, {-1, 2},
+};
+//! King offsets, indexed as `[Direction]`
+constexpr int kingOffsets[8][2] = {
+	{0, -1}, {-1, 0}, {-1, -1}, {1, -1},
+	{0, 1}, {1, 0}, {1, 1}, {-1, 1},
+};
+//! Knight destinations of every tile
+inline constexpr Steps<8> knightSteps(knightOffsets);
+//! King destinations of every tile
+inline constexpr Steps<8> kingSteps(kingOffsets);
+//! Pawn capture destinations of every tile, indexed as `[Piece::Color]`
+inline constexpr Steps<2> pawnSteps[2] = {
+	Steps<2>({{-1, -1}, {1, -1}}), Steps<2>({{-1, 1}, {1, 1}}),
+};
+
+/**
+ * @brief Knight destinations of every tile in Piece::moveMap() order
+ *
+ * Indexed as `[Piece::Color]`. Black offsets mirror the White
+ * ones, so the move maps of both colors list turns in the same
+ * order as seen from their own side of the board. Sliding
+ * pieces mirror their ray order the same way in
+ * Piece::diagonalMoves() and Piece::straightMoves().
+ */
+inline constexpr Steps<8> knightMoveSteps[2] = {
+	Steps<8>({
+		{2, -1}, {1, -2}, {-1, -2}, {-2, -1},
+		{2, 1}, {1, 2}, {-1, 2}, {-2, 1},
+	}),
+	Steps<8>({
+		{-2, 1}, {-1, 2}, {1, 2}, {2, 1},
+		{-2, -1}, {-1, -2}, {1, -2}, {2, -1},
+	}),
+};
+/**
+ * @brief King destinations of every tile in Piece::moveMap() order
+ *
+ * @copydetails knightMoveSteps
+ */
+inline constexpr Steps<8> kingMoveSteps[2] = {
+	Steps<8>({
+		{-1, -1}, {-1, 0}, {-1, 1}, {0, 1},
+		{1, 1}, {1, 0}, {1, -1}, {0, -1},
+	}),
+	Steps<8>({
+		{1, 1}, {1, 0}, {1, -1}, {0, -1},
+		{-1, -1}, {-1, 0}, {-1, 1}, {0, 1},
+	}),
+};
+
+/**
+ * @brief Rays from every tile to the board edge
+ *
+ * Compile time table, indexed as `[Direction][tile]`.
+ *
+ * @sa ray()
+ */
+struct Rays {
+	//! Construct new Rays table
+	constexpr Rays() {
+		for (int d = 0; d < 8; d++) {
+			for (int sq = 0; sq < 64; sq++) {
+				int dx = kingOffsets[d][0], dy = kingOffsets[d][1];
+				int x = squareX(sq) + dx, y = squareY(sq) + dy;
+				for ( ; x >= 1 and x <= 8 and y >= 1 and y <= 8; x += dx, y += dy)
+					to[d][sq] |= bit(square(x, y));
+			}
+		}
+	}
+	//! Ray tiles, indexed as `[Direction][tile]`
+	Bitboard to[8][64] = {};
+};
+//! Rays from every tile to the board edge
+inline constexpr Rays rays;
+
+/**
+ * @brief Tiles attacked by a bishop
+ *
+ * @param sq bishop tile index
+ * @param occupancy occupied tiles
+ * @return Bitboard of tiles that bishop at `sq` attacks,
+ * including the first occupied tile in every direction.
+ */
+inline Bitboard bishopAttacks(int sq, Bitboard occupancy) {
+	const Magic& m = slidingTables().bishopMagics[sq];
+	return m.attacks[m.index(occupancy)];
+}
+
+/**
+ * @brief Tiles attacked by a rook
+ *
+ * @copydetails bishopAttacks()
+ */
+inline Bitboard rookAttacks(int sq, Bitboard occupancy) {
+	const Magic& m = slidingTables().rookMagics[sq];
+	return m.attacks[m.index(occupancy)];
+}
+
+/**
+ * @brief Tiles attacked by a queen
+ *
+ * @copydetails bishopAttacks()
+ */
+inline Bitboard queenAttacks(int sq, Bitboard occupancy) {
+	return bishopAttacks(sq, occupancy) | rookAttacks(sq, occupancy);
+}
+
+/**
+ * @brief Tiles attacked by a knight
+ *
+ * @param sq knight tile index
+ * @return Bitboard of tiles that knight at `sq` attacks
+ */
+constexpr Bitboard knightAttacks(int sq) {
+	return knightSteps.targets[sq];
+}
+
+/**
+ * @brief Tiles attacked by a king
+ *
+ * @param sq king tile index
+ * @return Bitboard of tiles that king at `sq` attacks
+ */
+constexpr Bitboard kingAttacks(int sq) {
+	return kingSteps.targets[sq];
+}
+
+/**
+ * @brief Tiles attacked by a pawn
+ *
+ * White pawns attack towards the 8th rank,
+ * black ones towards the 1st.
+ *
+ * @param c pawn color
+ * @param sq pawn tile index
+ * @return Bitboard of tiles that pawn at `sq` attacks
+ */
+constexpr Bitboard pawnAttacks(Piece::Color c, int sq) {
+	return pawnSteps[static_cast<int>(c)].targets[sq];
+}
+
+/**
+ * @brief Ray from a tile to the board edge
+ *
+ * @param d ray direction
+ * @param sq ray origin, which is not a part of the ray
+ * @return Bitboard of ray tiles
+ */
+constexpr Bitboard ray(Direction d, int sq) {
+	return rays.to[d][sq];
+}
+
+}
+
+#endif // !_TARTAN_BOARD_ATTACKS_HPP_
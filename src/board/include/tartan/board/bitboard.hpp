@@ -0,0 +1,200 @@
+#ifndef _TARTAN_BOARD_BITBOARD_HPP_
+#define _TARTAN_BOARD_BITBOARD_HPP_
+
+#include <cstdint>
+#include <optional>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace tt {
+
+/**
+ * @brief Set of Board tiles packed into 64 bits
+ *
+ * Bit `n` describes the tile with index `n`, where tiles
+ * are indexed rank by rank starting from a1:
+ * a1 is 0, b1 is 1, ..., h1 is 7, a2 is 8, ..., h8 is 63.
+ *
+ * @sa square()
+ */
+using Bitboard = std::uint64_t;
+
+/**
+ * @brief Tile index of the (x, y) coordinates
+ *
+ * @param x x coordinate in range [1;8]
+ * @param y y coordinate in range [1;8]
+ * @return tile index in range [0;63]
+ * @sa Bitboard
+ */
+constexpr int square(int x, int y) { return (y - 1)*8 + (x - 1); }
+
+/**
+ * @brief x coordinate of tile index
+ *
+ * @param sq tile index
+ * @return x coordinate in range [1;8]
+ */
+constexpr int squareX(int sq) { return (sq & 7) + 1; }
+
+/**
+ * @brief y coordinate of tile index
+ *
+ * @param sq tile index
+ * @return y coordinate in range [1;8]
+ */
+constexpr int squareY(int sq) { return (sq >> 3) + 1; }
+
+/**
+ * @brief One byte tile index
+ *
+ * Value type for the tile index described in tt::Bitboard.
+ * Unlike Piece::Position it never throws: moving off the
+ * board is reported by tryOffset() with an empty
+ * `std::optional`, so leaper move generation can skip 
+ * off-board tiles without exceptions.
+ *
+ * @sa Piece::Position::square()
+ */
+class Square {
+public:
+	//! Construct Square at a1
+	constexpr Square() = default;
+	/**
+	 * @brief Construct new Square
+	 *
+	 * @warning `index` must be in range [0;63]
+	 *
+	 * @param index tile index
+	 */
+	constexpr explicit Square(int index) : s_index(static_cast<std::uint8_t>(index)) {};
+	/**
+	 * @brief Construct new Square
+	 *
+	 * @warning Coordinates must be in range [1;8]
+	 *
+	 * @param x x coordinate
+	 * @param y y coordinate
+	 */
+	constexpr Square(int x, int y) : Square(square(x, y)) {};
+	//! Tile index in range [0;63]
+	constexpr int index() const { return s_index; };
+	//! x coordinate in range [1;8]
+	constexpr int x() const { return squareX(s_index); };
+	//! y coordinate in range [1;8]
+	constexpr int y() const { return squareY(s_index); };
+	/**
+	 * @brief Offset tile
+	 *
+	 * @param dx x coordinate incrementation
+	 * @param dy y coordinate incrementation
+	 * @return Square at (x+dx, y+dy) or empty
+	 * `std::optional` if it is off the board
+	 */
+	constexpr std::optional<Square> tryOffset(int dx, int dy) const {
+		int nx = x() + dx, ny = y() + dy;
+		if (nx < 1 or nx > 8 or ny < 1 or ny > 8)
+			return std::nullopt;
+		return Square(nx, ny);
+	};
+	//! Comparison operator
+	friend constexpr bool operator==(Square lhs, Square rhs) { return lhs.s_index == rhs.s_index; };
+	//! Inverted comparison operator
+	friend constexpr bool operator!=(Square lhs, Square rhs) { return lhs.s_index != rhs.s_index; };
+private:
+	std::uint8_t s_index = 0;
+};
+
+/**
+ * @brief Bitboard with single tile set
+ *
+ * @param sq tile index
+ * @return Bitboard with only `sq` bit set
+ */
+constexpr Bitboard bit(int sq) { return Bitboard(1) << sq; }
+
+//! Bitboard of the a file
+constexpr Bitboard fileA = 0x0101010101010101ULL;
+//! Bitboard of the h file
+constexpr Bitboard fileH = fileA << 7;
+//! Bitboard of the first rank
+constexpr Bitboard rank1 = 0xFFULL;
+//! Bitboard of the eighth rank
+constexpr Bitboard rank8 = rank1 << 56;
+
+/**
+ * @brief Count of set tiles
+ *
+ * @param b Bitboard
+ * @return number of set bits in `b`
+ */
+inline int popcount(Bitboard b) {
+#if defined(_MSC_VER)
+	return static_cast<int>(__popcnt64(b));
+#else
+	return __builtin_popcountll(b);
+#endif
+}
+
+/**
+ * @brief Index of the least significant set tile
+ *
+ * @warning `b` must not be empty
+ *
+ * @param b Bitboard
+ * @return tile index
+ */
+inline int lsb(Bitboard b) {
+#if defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanForward64(&idx, b);
+	return static_cast<int>(idx);
+#else
+	return __builtin_ctzll(b);
+#endif
+}
+
+/**
+ * @brief Index of the most significant set tile
+ *
+ * @warning `b` must not be empty
+ *
+ * @param b Bitboard
+ * @return tile index
+ */
+inline int msb(Bitboard b) {
+#if defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanReverse64(&idx, b);
+	return static_cast<int>(idx);
+#else
+	return 63 ^ __builtin_clzll(b);
+#endif
+}
+
+/**
+ * @brief Pop the least significant set tile
+ *
+ * Clears the least significant set bit of `b`.
+ * Useful to iterate over the Bitboard:
+ * ```
+ * while (b)
+ *   int sq = popLsb(b);
+ * ```
+ *
+ * @warning `b` must not be empty
+ *
+ * @param[in,out] b Bitboard
+ * @return index of cleared tile
+ */
+inline int popLsb(Bitboard& b) {
+	int sq = lsb(b);
+	b &= b - 1;
+	return sq;
+}
+
+}
+
+#endif // !_TARTAN_BOARD_BITBOARD_HPP_
@@ -2,13 +2,17 @@
 #define _TARTAN_HPP_
 
 #include <array>
-#include <forward_list>
 #include <list>
+#include <optional>
 #include <ostream>
 #include <typeindex>
+#include <vector>
 #include <functional>
 #include <initializer_list>
 
+#include <tartan/board/bitboard.hpp>
+#include <tartan/board/status.hpp>
+
 //! Tartan library namespace
 namespace tt {
 
@@ -103,6 +107,33 @@ public:
 		 * @copydoc Position(const std::string&)
 		 */
 		Position(const char* str) : Position(std::string(str)) {};
+		/**
+		 * @brief Create Position object at `sq` tile
+		 *
+		 * @param sq tile
+		 */
+		explicit Position(Square sq) : p_x(sq.x()), p_y(sq.y()) {};
+		/**
+		 * @brief Create Position object at `x` `y`
+		 * without exceptions
+		 *
+		 * @param x x coordinate
+		 * @param y y coordinate
+		 * @return new Position object or empty `std::optional`
+		 * if coordinates are out of board
+		 * @sa Position(int, int)
+		 */
+		static std::optional<Position> tryPosition(int x, int y);
+		/**
+		 * @brief Create Position object at `str` position
+		 * without exceptions
+		 *
+		 * @param str 2-character letter-digit string representation of position
+		 * @return new Position object or empty `std::optional`
+		 * if `str` is not a valid position
+		 * @sa Position(const std::string&)
+		 */
+		static std::optional<Position> tryPosition(const std::string& str);
 	public:
 		/**
 		 * @brief Copy constructor
@@ -141,6 +172,12 @@ public:
 		 * @sa y()
 		 */
 		int digit() const { return p_y; };
+		/**
+		 * @brief Tile of the position
+		 *
+		 * @return Square with the same coordinates
+		 */
+		Square square() const { return Square(p_x, p_y); };
 		/**
 		 * @brief Set x coordinate
 		 *
@@ -203,6 +240,21 @@ public:
 		 * @sa offsetMode().
 		 */
 		Position offset(char dc, int dd) const;
+		/**
+		 * @brief Offset current position without throwing
+		 *
+		 * Works as offset(int dx, int dy), but reports
+		 * the off-board result with empty `std::optional` 
+		 * instead of the exception. Resulting position keeps 
+		 * current mode().
+		 *
+		 * @param dx x coordinate incrementation
+		 * @param dy y coordinate incrementation
+		 * @return new Position object at (x±dx, y±dy) or
+		 * empty `std::optional`
+		 * @sa mode().
+		 */
+		std::optional<Position> tryOffset(int dx, int dy) const;
 		/**
 		 * @brief Check if the position are at left border
 		 *
@@ -324,6 +376,7 @@ public:
 	 * derives from Piece.
 	 */
 	class Turn {
+		friend class Board;
 	public:
 		/**
 		 * @brief Construct new Turn object
@@ -421,6 +474,9 @@ public:
 		 * Opposite to apply(). Should be reimplemented
 		 * in child Piece class if it's apply() function 
 		 * does something special on applying.
+		 *
+		 * Board::turnIndex() and piece() Piece::turnIndex() 
+		 * are restored to values they had before apply().
 		 */
 		virtual void undo();
 		/**
@@ -470,6 +526,18 @@ public:
 		 * object indentical to invoking object
 		 */
 		virtual auto clone() const -> std::decay<decltype(*this)>::type*;
+		/**
+		 * @brief Replace Piece pointers of the Turn
+		 *
+		 * Used by Board::copyTo() to make copied history refer
+		 * to the copied pieces. Should be reimplemented in 
+		 * child Piece class if it's Turn keeps other Piece 
+		 * or Turn objects.
+		 *
+		 * @param map functor that returns new Piece pointer 
+		 * for the old one
+		 */
+		virtual void relink(const std::function<Piece*(const Piece*)>& map);
 		virtual ~Turn() = default;
 	protected:
 		//! %Turn piece starting position
@@ -482,6 +550,10 @@ public:
 		Piece* t_capture;
 		//! Turn viability
 		bool t_possible;
+		//! Board::turnIndex() before apply()
+		std::size_t t_turnIndex = 0;
+		//! piece() Piece::turnIndex() before apply()
+		std::size_t t_pieceTurnIndex = 0;
 	};
 	/**
 	 * @class TurnMap
@@ -496,7 +568,7 @@ public:
 		TurnMap(TurnMap&&);
 		//! Copy assignment operator
 		TurnMap& operator=(const TurnMap& other);
-		//! Move assignment operator
+		//! Move assignment operator, deletes the held Turn objects first
 		TurnMap& operator=(TurnMap&& other);
 		/**
 		 * @brief Viability of TurnMap
@@ -553,6 +625,15 @@ protected:
 	 * Piece performed some Turn
 	 */
 	std::size_t p_turnIndex = 0;
+	/**
+	 * @brief Piece type tag
+	 *
+	 * Small integer that identifies the derived Piece class,
+	 * so the Piece kind could be checked without RTTI. Values
+	 * are defined by the game that derives Piece classes.
+	 * @sa type()
+	 */
+	std::int8_t p_type = -1;
 public:
 	/**
 	 * @brief Piece color
@@ -560,6 +641,14 @@ public:
 	 * @return current Piece color value
 	 */
 	Color color() const { return p_color; };
+	/**
+	 * @brief Piece type tag
+	 *
+	 * @return type tag passed to the constructor, 
+	 * -1 if there was none
+	 * @sa p_type
+	 */
+	int type() const { return p_type; };
 	/**
 	 * @brief Set the color
 	 *
@@ -646,6 +735,21 @@ public:
 	 * @sa p_turnIndex
 	 */
 	std::size_t turnIndex() const { return p_turnIndex; }
+	/**
+	 * @brief Set moves count and turn index
+	 *
+	 * For positions that are loaded without the turns 
+	 * that led to them, so the Piece move rules that depend
+	 * on its history still apply.
+	 *
+	 * @param moves new movesMade() value
+	 * @param index new turnIndex() value
+	 * @sa p_movesMade, p_turnIndex
+	 */
+	void setMovesMade(std::size_t moves, std::size_t index = 0) {
+		p_movesMade = moves;
+		p_turnIndex = index;
+	};
 public:
 	/**
 	 * @brief Construct diagonal moves TurnMap
@@ -670,9 +774,10 @@ public:
 	 *
 	 * @param pos Piece Position
 	 * @param col Piece Color
-	 * @sa color(), position()
+	 * @param type Piece type tag
+	 * @sa color(), position(), type()
 	 */
-	Piece(const Position& pos = {1,1}, Color col = Color::White);
+	Piece(const Position& pos = {1,1}, Color col = Color::White, int type = -1);
 	virtual ~Piece() = default;
 };
 
@@ -690,16 +795,19 @@ using BoardT = std::array<std::array<Piece*, 8>, 8>;
  * tartan/board/exceptions.hpp.
  */
 class Board : private BoardT {
+	friend class Piece;
 	friend class Piece::Turn;
 public:
 	//! Type for list of captured Piece objects that no more on the board
-	using CapturedT = std::forward_list<const Piece*>;
+	using CapturedT = std::vector<const Piece*>;
 	//! Type for internal move history representation
 	using HistoryT = std::list<const Piece::Turn*>;
 	//! Type for representation a sequence of turns
 	using TurnsT = std::list<std::pair<Piece::Position, Piece::Position>>;
 	//! Type for representing set of pointers to Piece objects
 	using PieceSetT = std::list<Piece*>;
+	//! Type for list of Piece objects of one color on the Board
+	using PieceListT = std::vector<Piece*>;
 	//! Type used as argument to getPieceType()
 	using PieceTypesArgT = std::list<std::type_index>;
 	//! Type that getPieceType() should return
@@ -791,6 +899,40 @@ protected:
 	 * @sa canInsert()
 	 */
 	virtual Piece* placePiece(Piece* p);
+	/**
+	 * @name Tile hooks
+	 * Functions that are called every time the Piece 
+	 * objects on the Board change their tiles: on placePiece(),
+	 * Piece::move(), Turn::apply() and Turn::undo() captures, 
+	 * removePiece() and so on. Default implementation keeps 
+	 * the b_occupancy bitboards and b_pieces lists. Child classes can reimplement 
+	 * them to maintain their own incremental board representations,
+	 * but they should call the Board implementation.
+	 *
+	 * @warning Writing to the tile reference returned by at() or 
+	 * operator[]() does not call the hooks.
+	 */
+	//! @{
+	/**
+	 * @brief Called after the `p` were put at p->position()
+	 *
+	 * @param p placed Piece
+	 */
+	virtual void piecePlaced(const Piece* p);
+	/**
+	 * @brief Called after the `p` were removed from p->position()
+	 *
+	 * @param p removed Piece
+	 */
+	virtual void pieceRemoved(const Piece* p);
+	/**
+	 * @brief Called after the `p` were moved from `from` to p->position()
+	 *
+	 * @param p moved Piece
+	 * @param from previous `p` Position
+	 */
+	virtual void pieceMoved(const Piece* p, const Piece::Position& from);
+	//! @}
 	/**
 	 * @brief Make Turn object based on `from` and `to`
 	 *
@@ -814,17 +956,103 @@ protected:
 	 */
 	Piece::TurnMap produceTurn(const Piece::Position& from,
 													const Piece::Position& to, Piece::Turn** turn);
+	/**
+	 * @brief Make Turn object based on `from` and `to`
+	 * without exceptions
+	 *
+	 * Same as produceTurn(), but the errors are reported
+	 * with returned Status.
+	 *
+	 * @param from Piece::Position of Piece to move
+	 * @param to Piece::Position to move the Piece to
+	 * @param[out] possible TurnMap object of all possible moves,
+	 * left empty if the moved Piece was not found
+	 * @param[out] turn produced Piece::Turn object pointer selected 
+	 * from `possible`, set only on Status::Ok
+	 * @return Status::Ok, Status::TileIsEmpty, 
+	 * Status::PieceInWrongColor, Status::CanNotMove or
+	 * Status::NoSuchMove
+	 * @sa produceTurn()
+	 */
+	Status tryProduceTurn(const Piece::Position& from, const Piece::Position& to,
+												Piece::TurnMap& possible, Piece::Turn** turn);
 	/**
 	 * @brief Apply valid turn
 	 *
 	 * This function should describe things to do before 
 	 * the Turn::apply(int) is called. Current implementation
-	 * adds Turn::capture() to b_capturedPieces, then flips 
-	 * b_currentTurnColor to opposite.
+	 * adds Turn::capture() to b_capturedPieces, applies the 
+	 * turn and saves its clone to b_history, then flips 
+	 * b_currentTurnColor to opposite. Turn objects kept 
+	 * for redoTurn() are deleted.
 	 *
 	 * @param turn Turn object to apply
 	 */
 	virtual const Piece::Turn* applyTurn(Piece::Turn* turn);
+	/**
+	 * @brief Type of copyTo() Piece copying functor
+	 *
+	 * Should allocate the copy of the Piece object with 
+	 * the same dynamic type, Position, Color and counters.
+	 */
+	using PieceCopierT = std::function<Piece*(const Piece*)>;
+	/**
+	 * @brief Copy position to other Board
+	 *
+	 * Every Piece object is copied with `copy` and inserted 
+	 * into `b` with insertPiece(). Current turn color, 
+	 * turn index and piece getter are copied as well.
+	 *
+	 * Captured pieces and history are copied only if 
+	 * `history` is `true`. Turn objects of the copied history 
+	 * are relinked to the copied pieces with Turn::relink().
+	 *
+	 * @param b empty Board to copy the position to
+	 * @param copy Piece copying functor
+	 * @param history copy captured pieces and history too
+	 */
+	void copyTo(Board& b, const PieceCopierT& copy, bool history) const;
+	/**
+	 * @brief Remove Piece from b_capturedPieces
+	 *
+	 * Search starts from the last retired Piece, so 
+	 * taking back the last capture takes constant time.
+	 *
+	 * @param p Piece that returns to the Board
+	 */
+	void restoreCaptured(const Piece* p);
+public:
+	/**
+	 * @brief Take back the last applied Turn
+	 *
+	 * Calls Turn::undo() of the last history() Turn object,
+	 * removes its capture from the captured pieces and passes 
+	 * the turn back to the Turn piece color.
+	 *
+	 * Undone Turn objects are kept until the next applyTurn(),
+	 * so they could be applied again with redoTurn().
+	 *
+	 * @return undone Turn object or `nullptr` if history()
+	 * is empty
+	 * @sa redoTurn()
+	 */
+	virtual const Piece::Turn* undoTurn();
+	/**
+	 * @brief Apply the last undone Turn again
+	 *
+	 * Turn is applied with applyTurn().
+	 *
+	 * @return applied Turn object or `nullptr` if there
+	 * is no undone Turn objects
+	 * @sa undoTurn()
+	 */
+	const Piece::Turn* redoTurn();
+	/**
+	 * @brief Check if there is a Turn to redo
+	 *
+	 * @return `true` if redoTurn() will apply some Turn
+	 */
+	bool canRedo() const { return !b_undone.empty(); };
 public:
 	/**
 	 * @brief Internal board data structure
@@ -877,6 +1105,19 @@ public:
 	 * at p.position() is taken
 	 */
 	virtual Piece* canInsert(Piece* p) const;
+	/**
+	 * @brief Check if Piece can be placed at the Board
+	 * without exceptions
+	 *
+	 * Reimplement it along with canInsert() in child class
+	 * that adds its own insertion rules.
+	 *
+	 * @param p checked Piece object
+	 * @return Status::Ok, Status::ForeignPiece or
+	 * Status::PositionIsTaken
+	 * @sa canInsert()
+	 */
+	virtual Status checkInsert(const Piece* p) const;
 	/**
 	 * @brief Place piece on Board
 	 *
@@ -891,6 +1132,61 @@ public:
 	 * @return `p` pointer
 	 */
 	virtual Piece* insertPiece(Piece* p);
+	/**
+	 * @brief Place piece on Board without exceptions
+	 *
+	 * Piece is inserted with insertPiece() only if
+	 * checkInsert() reports Status::Ok.
+	 *
+	 * @note Board object takes the ownership of `p` only
+	 * if it was inserted.
+	 *
+	 * @param p Piece pointer to insert 
+	 * @return checkInsert() result
+	 */
+	Status tryInsertPiece(Piece* p);
+	/**
+	 * @brief Remove piece from Board
+	 *
+	 * Clears the tile at `pos` and passes the ownership
+	 * of Piece object that were there to the caller.
+	 *
+	 * @param pos Position of the removed Piece
+	 * @return removed Piece object
+	 * @exception ex::null_piece if tile at `pos` is empty
+	 */
+	virtual Piece* removePiece(const Piece::Position& pos);
+	/**
+	 * @brief Tiles occupied by pieces of certain color
+	 *
+	 * @param c Piece color
+	 * @return Bitboard of tiles with Piece objects of `c` color
+	 * @sa b_occupancy
+	 */
+	Bitboard occupancy(Piece::Color c) const { 
+		return b_occupancy[static_cast<int>(c)]; 
+	};
+	/**
+	 * @brief Tiles occupied by any Piece
+	 *
+	 * @return Bitboard of non-empty tiles
+	 * @sa b_occupancy
+	 */
+	Bitboard occupancy() const { return b_occupancy[0] | b_occupancy[1]; };
+	/**
+	 * @brief Pieces of certain color
+	 *
+	 * Every Piece object of `c` color on the Board in the
+	 * order of placement. Walking it touches only the live 
+	 * pieces instead of every tile.
+	 *
+	 * @param c Piece color
+	 * @return list of `c` colored Piece objects
+	 * @sa b_pieces
+	 */
+	const PieceListT& pieces(Piece::Color c) const { 
+		return b_pieces[static_cast<int>(c)]; 
+	};
 	/**
 	 * @brief Clears current Board 
 	 *
@@ -958,6 +1254,21 @@ public:
 	 * @se piece()
 	 */
 	void fill(std::initializer_list<const std::string> list);
+	/**
+	 * @brief Fill Board with string representation of
+	 * Piece objects without exceptions
+	 *
+	 * Every spec is parsed with tryPiece() first, so 
+	 * Board is not changed if some spec is invalid. Then
+	 * pieces are inserted with tryInsertPiece() until the
+	 * first failure; pieces inserted before it stay on the Board,
+	 * the rest are deleted.
+	 *
+	 * @param str space separated set of piece specs
+	 * @return Status::BadPieceSpec or tryInsertPiece() result
+	 * @sa fill(const std::string&)
+	 */
+	Status tryFill(const std::string& str);
 	 //! Clear and fill Board with default piece set
 	void refill() { clear(); fill(); };
 	//! @}
@@ -1112,6 +1423,19 @@ public:
 	 * `spec` string
 	 */	
 	virtual Piece* piece(const std::string& spec) const = 0;
+	/**
+	 * @brief Convert std::string Piece spec to 
+	 * actual Piece object pointer without exceptions
+	 *
+	 * Default implementation calls piece() and
+	 * catches the ex::bad_piece_spec, so child classes
+	 * should reimplement it with parsing that does not throw.
+	 *
+	 * @param spec Piece std::string specification
+	 * @return pointer to Piece object constructed from
+	 * `spec` string or `nullptr` if `spec` is invalid
+	 */
+	virtual Piece* tryPiece(const std::string& spec) const;
 private:
 	void fillBoardWithNullptrs();
 protected:
@@ -1126,6 +1450,7 @@ protected:
 	 * Pieces that have retired and have been removed from 
 	 * Board should go to this list. The default applyTurn()
 	 * function does that if turn catures something.
+	 * The last retired Piece is at the back.
 	 */
 	CapturedT b_capturedPieces;
 	/**
@@ -1137,6 +1462,14 @@ protected:
 	 * @sa history(), HistoryT
 	 */
 	HistoryT b_history;
+	/**
+	 * @brief Turn objects taken back with undoTurn()
+	 *
+	 * The last undone Turn is at the back. List is cleared
+	 * by applyTurn().
+	 * @sa redoTurn()
+	 */
+	HistoryT b_undone;
 	/**
 	 * @brief Piece getter variable
 	 *
@@ -1156,6 +1489,22 @@ protected:
 	 * that belongs to current Board object.
 	 */
 	std::size_t b_turnIndex = 0;
+	/**
+	 * @brief Occupied tiles of each Piece::Color
+	 *
+	 * Indexed by Piece::Color value. Maintained with the 
+	 * @ref piecePlaced() "tile hooks".
+	 * @sa occupancy()
+	 */
+	Bitboard b_occupancy[2] = {0, 0};
+	/**
+	 * @brief Piece objects of each Piece::Color
+	 *
+	 * Indexed by Piece::Color value. Maintained with the 
+	 * @ref piecePlaced() "tile hooks".
+	 * @sa pieces()
+	 */
+	PieceListT b_pieces[2];
 };
 
 }
@@ -0,0 +1,81 @@
+#ifndef _TARTAN_BOARD_STATUS_HPP_
+#define _TARTAN_BOARD_STATUS_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+
+#if !defined(__cpp_exceptions) && !defined(_CPPUNWIND)
+/**
+ * @brief Defined when the library is built without
+ * exception support
+ *
+ * @sa TARTAN_THROW
+ */
+#define TARTAN_NO_EXCEPTIONS
+#endif
+
+#ifndef TARTAN_NO_EXCEPTIONS
+/**
+ * @brief Throw exception object
+ *
+ * Every library exception is thrown with this macro.
+ * If the library is built without exceptions
+ * (`-fno-exceptions`, see the `TARTAN_EXCEPTIONS` CMake option),
+ * the exception object is not constructed and
+ * the program is aborted with std::abort().
+ * Use the `try*` functions that report errors with
+ * tt::Status in that case.
+ */
+#define TARTAN_THROW(...) throw __VA_ARGS__
+#else
+#define TARTAN_THROW(...) std::abort()
+#endif
+
+namespace tt {
+
+/**
+ * @brief Result of the non-throwing functions
+ *
+ * Most values correspond to the exception the throwing
+ * version of the function reports the same error with,
+ * the rest are reported by the functions that have no
+ * throwing version. Status values carry
+ * no message and no objects, so reporting them
+ * costs nothing.
+ *
+ * @sa Board::tryFill(), Board::tryInsertPiece(),
+ * chess::Chessboard::tryMakeTurn(), chess::Chessboard::findSAN()
+ */
+enum class Status : std::uint8_t {
+	Ok,                ///< No error
+	BadPieceSpec,      ///< ex::bad_piece_spec
+	ForeignPiece,      ///< ex::foreign_piece
+	PositionIsTaken,   ///< ex::position_is_taken
+	DuplicateKing,     ///< chess::ex::duplicate_king
+	TooManyPieces,     ///< chess::ex::too_many_pieces
+	TileIsEmpty,       ///< ex::tile_is_empty
+	PieceInWrongColor, ///< ex::piece_in_wrong_color
+	CanNotMove,        ///< ex::can_not_move
+	NoSuchMove,        ///< ex::no_such_move
+	NoKing,            ///< chess::ex::no_king
+	Check,             ///< chess::ex::check
+	Checkmate,         ///< chess::ex::checkmate
+	NoPieceGetter,     ///< Board::getPieceType() std::runtime_error
+	BadFen,            ///< chess::ex::bad_fen
+	BadPieceType,      ///< ex::bad_piece_type
+	BadSan,            ///< Malformed SAN move
+	AmbiguousMove,     ///< SAN move matches several legal moves
+};
+
+/**
+ * @brief Status description
+ *
+ * @param s described status
+ * @return static string, the default message of
+ * corresponding exception if there is one
+ */
+const char* what(Status s);
+
+}
+
+#endif // !_TARTAN_BOARD_STATUS_HPP_
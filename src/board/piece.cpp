@@ -1,11 +1,13 @@
 #include <tartan/board.hpp>
+#include <tartan/board/attacks.hpp>
 
 namespace tt {
 using Position = Piece::Position;
 
-Piece::Piece(const Position&  p, Color c) { 
+Piece::Piece(const Position&  p, Color c, int t) { 
 	p_position = p; 
 	p_color = c; 
+	p_type = static_cast<std::int8_t>(t);
 };
 
 Board* Piece::setBoard(Board* cb) {
@@ -24,6 +26,7 @@ Position Piece::move(const Position& p) {
 	p_board->at(p) = this;
 
 	p_position = p;
+	p_board->pieceMoved(this, ret);
 	return ret;
 }
 
@@ -39,78 +42,53 @@ Piece::Color Piece::setColor(Color c) {
 	return ret;
 }
 
-Piece::TurnMap Piece::diagonalMoves(const Piece* p) {
-	TurnMap map;
-	Position tpos, pos = p->p_position;
-	Piece* enemy;
-
-	if (p->p_color == Piece::Color::Black) {
-		pos.setMode(Position::Mode::Reverse);
-		tpos.setMode(Position::Mode::Reverse);
+namespace {
+
+// pushes turns to every tile of `attacks` along the direction,
+// starting from the farthest tile of the ray
+template<Direction D>
+void pushRay(Piece::TurnMap& map, const Piece* p, Bitboard attacks, int sq) {
+	const Board* b = p->board();
+	Bitboard r = attacks & ray(D, sq);
+	while (r) {
+		int to = (D & Positive) ? msb(r) : lsb(r);
+		r ^= bit(to);
+		Position tpos(squareX(to), squareY(to));
+		map.push_back(new Piece::Turn(p, tpos, b->at(tpos)));
 	}
+}
 
-	using func = bool (Position::*)(void) const;
-	std::tuple<func, func, std::pair<int, int>> conds[4] = {
-		{&Position::atRight, &Position::atBottom, {1, -1}},
-		{&Position::atRight, &Position::atTop, {1, 1}},
-		{&Position::atLeft, &Position::atBottom, {-1, -1}},
-		{&Position::atLeft, &Position::atTop, {-1, 1}},
-	};
-
-	for (auto& v: conds) {
-		tpos = pos;
-		while (!(tpos.*std::get<0>(v))() and !(tpos.*std::get<1>(v))()) {
-			std::pair<int, int> of = std::get<2>(v);
-			tpos = tpos.offset(of.first, of.second);
-			enemy = p->p_board->at(tpos);
-			if (!enemy)
-				map.push_front(new Turn(p, tpos));
-			else if (enemy->p_color != p->p_color) {
-				map.push_front(new Turn(p, tpos, enemy));
-				break;
-			} else if (enemy->p_color == p->p_color) 
-				break;
-		}
-	}
-	
+template<Direction... Ds>
+Piece::TurnMap rayMoves(const Piece* p, Bitboard attacks) {
+	Piece::TurnMap map;
+	int sq = p->position().square().index();
+	(pushRay<Ds>(map, p, attacks, sq), ...);
 	return map;
 }
 
-Piece::TurnMap Piece::straightMoves(const Piece* p) {
-	TurnMap map;
-	Position tpos, pos = p->p_position;
-	Piece* enemy;
-
-	if (p->p_color == Piece::Color::Black) {
-		pos.setMode(Position::Mode::Reverse);
-		tpos.setMode(Position::Mode::Reverse);
-	}
+}
 
-	using func = bool (Position::*)(void) const;
-	std::tuple<func, std::pair<int, int>> conds[4] = {
-		{&Position::atBottom, {0, -1}},
-		{&Position::atTop, {0, 1}},
-		{&Position::atLeft, {-1, 0}},
-		{&Position::atRight, {1, 0}},
-	};
-
-	for (auto& v: conds) {
-		tpos = pos;
-		while (!(tpos.*std::get<0>(v))()) {
-			std::pair<int, int> of = std::get<1>(v);
-			tpos = tpos.offset(of.first, of.second);
-			enemy = p->p_board->at(tpos);
-			if (!enemy)
-				map.push_front(new Turn(p, tpos));
-			else if (enemy->p_color != p->p_color) {
-				map.push_front(new Turn(p, tpos, enemy));
-				break;
-			} else if (enemy->p_color == p->p_color) 
-				break;
-		}
-	}
+Piece::TurnMap Piece::diagonalMoves(const Piece* p) {
+	const Board* b = p->p_board;
+	Bitboard attacks = 
+		bishopAttacks(p->p_position.square().index(), b->occupancy()) & 
+		~b->occupancy(p->p_color);
+
+	// ray order is mirrored for black, see knightMoveSteps
+	return p->p_color == Color::Black ?
+		rayMoves<SouthEast, NorthEast, SouthWest, NorthWest>(p, attacks) :
+		rayMoves<NorthWest, SouthWest, NorthEast, SouthEast>(p, attacks);
+}
 
-	return map;
+Piece::TurnMap Piece::straightMoves(const Piece* p) {
+	const Board* b = p->p_board;
+	Bitboard attacks = 
+		rookAttacks(p->p_position.square().index(), b->occupancy()) & 
+		~b->occupancy(p->p_color);
+
+	return p->p_color == Color::Black ?
+		rayMoves<West, East, South, North>(p, attacks) :
+		rayMoves<East, West, North, South>(p, attacks);
 }
 
 }
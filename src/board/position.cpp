@@ -26,7 +26,7 @@ Position::Position(char l, int d) {
 
 Position::Position(const string& s) {
 	if (s.length() != 2)
-		throw invalid_argument("Could not get position from string.");
+		TARTAN_THROW(invalid_argument("Could not get position from string."));
 	string str = s;
 	std::transform(s.begin(), s.end(), str.begin(), [](unsigned char c) { 
 		return std::tolower(c); }
@@ -36,11 +36,26 @@ Position::Position(const string& s) {
 	setDigit(str[1] - '1' + 1);
 }
 
+std::optional<Position> Position::tryPosition(int x, int y) {
+	std::optional<Position> ret;
+	if (x >= 1 and x <= 8 and y >= 1 and y <= 8)
+		ret.emplace(Square(x, y));
+	return ret;
+}
+
+std::optional<Position> Position::tryPosition(const string& s) {
+	if (s.length() != 2)
+		return std::nullopt;
+	return tryPosition(
+		std::tolower(static_cast<unsigned char>(s[0])) - 'a' + 1, s[1] - '1' + 1
+	);
+}
+
 int Position::setX(int x) {
 	if (x < 1 or x >  8) {
-		throw out_of_range(
+		TARTAN_THROW(out_of_range(
 			string("Chess piece x position can't be ") + 
-			to_string(x) + ".");
+			to_string(x) + "."));
 	}
 
 	short ret = p_x;
@@ -51,9 +66,9 @@ int Position::setX(int x) {
 
 int Position::setY(int y) {
 	if (y < 1 or y >  8) {
-		throw out_of_range(
+		TARTAN_THROW(out_of_range(
 			string("Chess piece y position can't be ") + 
-			to_string(y) + ".");
+			to_string(y) + "."));
 	}
 
 	short ret = p_y;
@@ -73,6 +88,18 @@ Position Position::offset(char ol, int od) const {
 	return offset(ol - 'a' + 1, od);
 }
 
+std::optional<Position> Position::tryOffset(int ox, int oy) const {
+	int k = static_cast<int>(p_mode);
+	std::optional<Square> sq = square().tryOffset(k*ox, k*oy);
+	// single return object, copying Position drops the mode
+	std::optional<Position> ret;
+	if (sq) {
+		ret.emplace(*sq);
+		ret->p_mode = p_mode;
+	}
+	return ret;
+}
+
 bool Position::atLeft() const {
 	if (p_mode == Mode::Normal)
 		return p_x == 1;
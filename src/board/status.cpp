@@ -0,0 +1,29 @@
+#include <tartan/board/status.hpp>
+
+namespace tt {
+
+const char* what(Status s) {
+	switch (s) {
+		case Status::Ok: return "No error";
+		case Status::BadPieceSpec: return "Invalid piece specification";
+		case Status::ForeignPiece: return "Piece does not belong to this board";
+		case Status::PositionIsTaken: return "Piece position is taken";
+		case Status::DuplicateKing: return "Board already has a king";
+		case Status::TooManyPieces: return "Side has more pieces than a game can have";
+		case Status::TileIsEmpty: return "Selected tile is empty";
+		case Status::PieceInWrongColor: return "Moved piece is in wrong color";
+		case Status::CanNotMove: return "Selected piece can't move";
+		case Status::NoSuchMove: return "Selected piece can't perform such move";
+		case Status::NoKing: return "Board does not have a king";
+		case Status::Check: return "King is under check after move";
+		case Status::Checkmate: return "King is under checkmate";
+		case Status::NoPieceGetter: return "Piece getter is not set.";
+		case Status::BadFen: return "Invalid FEN string";
+		case Status::BadPieceType: return "Piece type is illegal";
+		case Status::BadSan: return "Invalid SAN move";
+		case Status::AmbiguousMove: return "SAN move is ambiguous";
+	}
+	return "Unknown status";
+}
+
+}
@@ -7,7 +7,7 @@ using Turn = Piece::Turn;
 
 Turn::Turn(const Piece* p, const Position& t, const Piece* c, bool u) {
 	if (p == nullptr)
-		throw ex::illegal_turn("Turn piece cannot be nullptr.");
+		TARTAN_THROW(ex::illegal_turn("Turn piece cannot be nullptr."));
 	t_piece = const_cast<Piece*>(p);
 	t_to = t;
 	t_from = p->position();
@@ -17,10 +17,14 @@ Turn::Turn(const Piece* p, const Position& t, const Piece* c, bool u) {
 
 void Turn::apply(int) {
 	Board& cb = *t_piece->p_board;
+	t_turnIndex = cb.b_turnIndex;
+	t_pieceTurnIndex = t_piece->p_turnIndex;
 	cb.b_turnIndex++;
 	
-	if (t_capture)
+	if (t_capture) {
 		cb[t_capture->position()] = nullptr;
+		cb.pieceRemoved(t_capture);
+	}
 
 	t_piece->move(t_to);
 }
@@ -30,10 +34,19 @@ void Turn::undo() {
 
 	t_piece->move(t_from);
 
-	if (t_capture)
+	if (t_capture) {
 		cb[t_capture->position()] = t_capture;
+		cb.piecePlaced(t_capture);
+	}
 
 	t_piece->p_movesMade -= 2;
+	t_piece->p_turnIndex = t_pieceTurnIndex;
+	cb.b_turnIndex = t_turnIndex;
+}
+
+void Turn::relink(const std::function<Piece*(const Piece*)>& map) {
+	t_piece = map(t_piece);
+	t_capture = map(t_capture);
 }
 
 bool Turn::isEqual(const Turn& rhs) const {
@@ -26,6 +26,11 @@ TurnMap& TurnMap::operator=(const TurnMap& t) {
 }
 
 TurnMap& TurnMap::operator=(TurnMap&& t) {
+	if (this == &t)
+		return *this;
+	std::for_each(begin(), end(), [](Turn* turn) {
+		delete turn;
+	});
 	static_cast<list<Turn*>&>(*this) = std::move(t);
 	t.clear();
 	return *this;
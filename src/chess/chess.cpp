@@ -1,7 +1,11 @@
 #include <tartan/chess.hpp>
 #include <tartan/chess/exceptions.hpp>
+#include <tartan/board/attacks.hpp>
 
+#include <algorithm>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <cctype>
 
 namespace tt::chess {
@@ -10,89 +14,156 @@ using Position = Piece::Position;
 using Turn = Piece::Turn;
 using Color = Piece::Color;
 
-Piece* Chessboard::piece(const std::string& spec) const {
+namespace {
+
+int square(const Position& p) {
+	return tt::square(p.x(), p.y());
+}
+
+Position position(int sq) {
+	return {squareX(sq), squareY(sq)};
+}
+
+// nullptr if `spec` is valid, reason why it is not otherwise
+const char* parse(const std::string& spec, Piece*& piece) {
 	if (spec.size() > 3)
-		throw tt::ex::bad_piece_spec(spec, "Specification is too long");
+		return "Specification is too long";
 	if (spec.size() < 3)
-		throw tt::ex::bad_piece_spec(spec, "Specification is too short");
+		return "Specification is too short";
 
 	char p = spec[0];
-	Piece::Color color;
 	if (!isalpha(p))
-		throw tt::ex::bad_piece_spec(spec, "Specified piece type is unknown");
-
-	if (isupper(p))
-		color = Piece::Color::White;
-	else
-		color = Piece::Color::Black;
-
-	Position position;
-	try {
-		position = spec.substr(1, 2);
-	} catch (std::out_of_range& ex) {
-		std::throw_with_nested(tt::ex::bad_piece_spec(
-			spec, "Specified position is out of range"
-		));
-	}
-	
-	Piece* newPiece;
+		return "Specified piece type is unknown";
+
+	std::optional<Position> position = Position::tryPosition(spec.substr(1, 2));
+	if (!position)
+		return "Specified position is out of range";
+
 	switch (tolower(p)) {
 		case 'p': {
-			newPiece = new Pawn;
+			piece = new Pawn;
 			break;
 		}
 		case 'b': {
-			newPiece = new Bishop;
+			piece = new Bishop;
 			break;
 		}
 		case 'k': {
-			newPiece = new Knight;
+			piece = new Knight;
 			break;
 		}
 		case 'r': {
-			newPiece = new Rook;
+			piece = new Rook;
 			break;
 		}
 		case 'q': {
-			newPiece = new Queen;
+			piece = new Queen;
 			break;
 		}
 		case 'x': {
-			newPiece = new King;
+			piece = new King;
 			break;
 		}
 		default:
-			throw tt::ex::bad_piece_spec(spec, "Specified piece type is unknown");
+			return "Specified piece type is unknown";
 	}
 
-	newPiece->setColor(color);
-	newPiece->setPosition(position);
+	piece->setColor(isupper(p) ? Piece::Color::White : Piece::Color::Black);
+	piece->setPosition(*position);
+	return nullptr;
+}
 
-	return newPiece;
+Move move(const Turn& t, const State& s) {
+	int from = square(t.from()), to = square(t.to());
+	int flags = Move::Quiet;
+	if (t.capture()) {
+		flags = square(t.capture()->position()) == to ? 
+			Move::Capture : Move::EnPassant;
+	} else if (s.type(from) == PieceType::King) {
+		if (to - from == 2)
+			flags = Move::KingCastle;
+		else if (from - to == 2)
+			flags = Move::QueenCastle;
+	}
+	return Move(from, to, flags);
 }
 
-Piece* Chessboard::canInsert(Piece* p) const {
-	Board::canInsert(p);
+}
 
-	King* king = dynamic_cast<King*>(p);
-	if (king) {
-		if (king->color() == Piece::Color::White) {
-			if (c_whiteKing)
-				throw ex::duplicate_king(p);
-		} else if (king->color() == Piece::Color::Black) {
-			if (c_blackKing) 
-				throw ex::duplicate_king(p);
+std::type_index promotionType(PieceType t) {
+	switch (t) {
+		case PieceType::Knight: return typeid(Knight);
+		case PieceType::Bishop: return typeid(Bishop);
+		case PieceType::Rook: return typeid(Rook);
+		default: return typeid(Queen);
+	}
+}
+
+bool promotionType(const std::type_index& type, PieceType& t) {
+	for (PieceType p : {PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen}) {
+		if (type == promotionType(p)) {
+			t = p;
+			return true;
 		}
 	}
+	return false;
+}
 
+Chessboard::~Chessboard() {
+	clear();
+}
+
+Piece* Chessboard::piece(const std::string& spec) const {
+	Piece* p = nullptr;
+	const char* error = parse(spec, p);
+	if (error)
+		TARTAN_THROW(tt::ex::bad_piece_spec(spec, error));
 	return p;
 }
 
+Piece* Chessboard::tryPiece(const std::string& spec) const {
+	Piece* p = nullptr;
+	return parse(spec, p) ? nullptr : p;
+}
+
+Piece* Chessboard::canInsert(Piece* p) const {
+	Board::canInsert(p);
+
+	switch (checkInsert(p)) {
+		case Status::DuplicateKing:
+			TARTAN_THROW(ex::duplicate_king(p));
+		case Status::TooManyPieces:
+			TARTAN_THROW(ex::too_many_pieces(p));
+		default:
+			return p;
+	}
+}
+
+Status Chessboard::checkInsert(const Piece* p) const {
+	if (Status s = Board::checkInsert(p); s != Status::Ok)
+		return s;
+
+	if (p->type() == State::index(PieceType::King)) {
+		if (p->color() == Piece::Color::White ? c_whiteKing : c_blackKing)
+			return Status::DuplicateKing;
+	}
+
+	PieceType t;
+	if (pieceType(p, t)) {
+		State s = c_state;
+		s.put(square(p->position()), p->color(), t);
+		if (!s.hasPossibleMaterial(p->color()))
+			return Status::TooManyPieces;
+	}
+
+	return Status::Ok;
+}
+
 Piece* Chessboard::insertPiece(Piece* p) {
 	canInsert(p);
 
-	King* king = dynamic_cast<King*>(p);
-	if (king) {
+	if (p->type() == State::index(PieceType::King)) {
+		King* king = static_cast<King*>(p);
 		if (king->color() == Piece::Color::White) {
 				c_whiteKing = king;
 				c_currentKing = king;
@@ -102,7 +173,9 @@ Piece* Chessboard::insertPiece(Piece* p) {
 		}
 	}
 		
-	return placePiece(p);
+	placePiece(p);
+	updateCastling();
+	return p;
 }
 
 Piece::TurnMap Chessboard::possibleMoves(const Piece* p) const {
@@ -111,32 +184,325 @@ Piece::TurnMap Chessboard::possibleMoves(const Piece* p) const {
 	return map;
 }
 
+const Turn* Chessboard::applyTurn(Turn* t) {
+	int from = square(t->from()), to = square(t->to());
+	bool pawn = c_state.type(from) == PieceType::Pawn;
+	Record r = {
+		static_cast<std::uint8_t>(c_state.castling()),
+		static_cast<std::int8_t>(c_state.enPassant()),
+		c_halfmoveClock
+	};
+
+	Board::applyTurn(t);
+
+	c_records.push_back(r);
+	c_halfmoveClock = pawn or t->capture() ? 0 : c_halfmoveClock + 1;
+
+	updateCastling();
+	c_state.setEnPassant(
+		pawn and (to - from == 16 or from - to == 16) ? (from + to)/2 : -1
+	);
+	return t;
+}
+
+const Turn* Chessboard::undoTurn() {
+	const Turn* t = Board::undoTurn();
+	if (!t)
+		return nullptr;
+
+	const Record& r = c_records.back();
+	c_state.setCastling(r.castling);
+	c_state.setEnPassant(r.enPassant);
+	c_halfmoveClock = r.halfmoveClock;
+	c_records.pop_back();
+	return t;
+}
+
+bool Chessboard::isSquareAttacked(const Position& pos, Color by) const {
+	return c_state.isSquareAttacked(square(pos), by);
+}
+
+Bitboard Chessboard::attackersOf(const Position& pos) const {
+	return c_state.attackersOf(square(pos));
+}
+
+void Chessboard::legalMoves(MoveList& list, Color c) const {
+	if (!c_state.pieces(c, PieceType::King))
+		TARTAN_THROW(ex::no_king(c));
+	c_state.generateLegal(list, c);
+}
+
+TurnMap Chessboard::turns(const MoveList& list) const {
+	TurnMap map;
+	for (Move m : list) {
+		const Piece* p = at(position(m.from()));
+		Position to = position(m.to());
+		const Piece* capture = at(to);
+		if (m.enPassant())
+			capture = at(position(m.to() + (p->color() == Color::White ? -8 : 8)));
+
+		switch (c_state.type(m.from())) {
+			case PieceType::Pawn:
+				if (m.promotion())
+					map.push_back(new Pawn::Turn(p, to, capture, promotionType(m.promoteTo())));
+				else
+					map.push_back(new Pawn::Turn(p, to, capture));
+				break;
+			case PieceType::Knight:
+				map.push_back(new Knight::Turn(p, to, capture));
+				break;
+			case PieceType::Bishop:
+				map.push_back(new Bishop::Turn(p, to, capture));
+				break;
+			case PieceType::Rook:
+				map.push_back(new Rook::Turn(p, to, capture));
+				break;
+			case PieceType::Queen:
+				map.push_back(new Queen::Turn(p, to, capture));
+				break;
+			case PieceType::King: {
+				Rook::Turn* castling = nullptr;
+				if (m.flags() == Move::KingCastle)
+					castling = new Rook::Turn(at(position(m.to() + 1)), position(m.to() - 1));
+				else if (m.flags() == Move::QueenCastle)
+					castling = new Rook::Turn(at(position(m.to() - 2)), position(m.to() + 1));
+				map.push_back(new King::Turn(p, to, capture, castling));
+				break;
+			}
+		}
+	}
+	return map;
+}
+
+std::unique_ptr<Chessboard> Chessboard::clone(bool history) const {
+	auto copy = [](const Piece* p) {
+		return visit(p, [](const auto* q) -> Piece* {
+			return new std::decay_t<decltype(*q)>(*q);
+		});
+	};
+
+	std::unique_ptr<Chessboard> cb(new Chessboard);
+	copyTo(*cb, copy, history);
+	cb->c_state.setEnPassant(c_state.enPassant());
+	cb->c_halfmoveClock = c_halfmoveClock;
+	cb->c_fullmoveNumber = history ? c_fullmoveNumber : fullmoveNumber();
+	if (history)
+		cb->c_records = c_records;
+	return cb;
+}
+
 const Turn* Chessboard::makeTurn(const Position& from, const Position& to) {
-	Turn* selected;
-	TurnMap map = Board::produceTurn(from, to, &selected);
+	const Turn* turn = nullptr;
+	switch (tryMakeTurn(from, to, &turn)) {
+		case Status::TileIsEmpty:
+			TARTAN_THROW(tt::ex::tile_is_empty(from, to));
+		case Status::PieceInWrongColor:
+			TARTAN_THROW(tt::ex::piece_in_wrong_color(at(from), to));
+		case Status::CanNotMove:
+			TARTAN_THROW(tt::ex::can_not_move(at(from), to));
+		case Status::NoSuchMove:
+			TARTAN_THROW(tt::ex::no_such_move(at(from), to));
+		case Status::NoKing:
+			TARTAN_THROW(ex::no_king(b_currentTurnColor));
+		case Status::Checkmate:
+			TARTAN_THROW(ex::checkmate(at(from), to, c_currentKing));
+		case Status::Check:
+			TARTAN_THROW(ex::check(at(from), to, c_currentKing));
+		case Status::NoPieceGetter:
+			TARTAN_THROW(std::runtime_error("Piece getter is not set."));
+		case Status::BadPieceType:
+			TARTAN_THROW(tt::ex::bad_piece_type());
+		default:
+			return turn;
+	}
+}
 
-	if (c_currentKing->checkmate())
-		throw ex::checkmate(selected->piece(), selected->to(), c_currentKing);
+Status Chessboard::tryMakeTurn(const Position& from, const Position& to, const Turn** turn) {
+	if (Move m = findMove(square(from), square(to))) {
+		if (m.promotion()) {
+			if (!b_pieceGetter)
+				return Status::NoPieceGetter;
+			// same order as in Pawn::moveMap()
+			PieceTypesArgT types = {
+				typeid(Queen), typeid(Bishop), typeid(Rook), typeid(Knight)
+			};
+			std::type_index type = getPieceType(types);
+			PieceType t;
+			if (std::find(types.begin(), types.end(), type) == types.end() or 
+				!promotionType(type, t))
+				return Status::BadPieceType;
+			m = Move(m.from(), m.to(), 
+				Move::Promotion | (State::index(t) - 1) | (m.flags() & Move::Capture));
+		}
+		applyMove(m);
+	} else {
+		const Piece* p = at(from);
+		if (p and p->color() == b_currentTurnColor and !c_currentKing)
+			return Status::NoKing;
+
+		Turn* selected;
+		TurnMap map;
+		if (Status s = Board::tryProduceTurn(from, to, map, &selected); s != Status::Ok)
+			return s;
+
+		if (c_currentKing->checkmate())
+			return Status::Checkmate;
+
+		if (!selected->possible())
+			return Status::Check;
+
+		if (selected->piece()->type() == State::index(PieceType::Pawn) and
+			static_cast<Pawn::Turn*>(selected)->promoteTo() != typeid(nullptr)) {
+			if (!b_pieceGetter)
+				return Status::NoPieceGetter;
+			PieceTypesArgT types;
+			for (Turn* t : map)
+				if (t->from() == from and t->to() == to)
+					types.push_back(static_cast<Pawn::Turn*>(t)->promoteTo());
+			std::type_index type = getPieceType(types);
+			if (std::find(types.begin(), types.end(), type) == types.end())
+				return Status::BadPieceType;
+			for (Turn* t : map)
+				if (t->from() == from and t->to() == to and 
+					static_cast<Pawn::Turn*>(t)->promoteTo() == type)
+					selected = t;
+		}
 
-	if (!selected->possible())
-		throw ex::check(selected->piece(), selected->to(), c_currentKing);
+		applyTurn(selected);
+	}
+
+	if (turn)
+		*turn = b_history.back();
+	return Status::Ok;
+}
 
-	return applyTurn(selected);
+const Turn* Chessboard::applyMove(Move m) {
+	MoveList list;
+	list.push_back(m);
+	TurnMap map = turns(list);
+	applyTurn(map.front());
+	return b_history.back();
+}
+
+Move Chessboard::findMove(int from, int to) const {
+	const State& s = c_state;
+	Color side = b_currentTurnColor;
+	Color enemy = side == Color::White ? Color::Black : Color::White;
+	Bitboard own = s.occupancy(side), all = s.occupancy();
+	if (!(own & bit(from)) or (own & bit(to)) or !c_currentKing)
+		return Move();
+
+	int flags = (s.occupancy(enemy) & bit(to)) ? Move::Capture : Move::Quiet;
+	bool valid = false;
+	switch (s.type(from)) {
+		case PieceType::Pawn: {
+			int forward = side == Color::White ? 8 : -8;
+			int initial = side == Color::White ? 2 : 7;
+			if (to == from + forward) {
+				valid = !(all & bit(to));
+			} else if (to == from + 2*forward) {
+				valid = squareY(from) == initial and 
+					!(all & (bit(from + forward) | bit(to)));
+				flags = Move::DoublePush;
+			} else if (pawnAttacks(side, from) & bit(to)) {
+				valid = flags == Move::Capture or to == s.enPassant();
+				if (to == s.enPassant())
+					flags = Move::EnPassant;
+			}
+			if (to >= 56 or to < 8)
+				flags |= Move::QueenPromotion;
+			break;
+		}
+		case PieceType::Knight:
+			valid = knightAttacks(from) & bit(to);
+			break;
+		case PieceType::Bishop:
+			valid = bishopAttacks(from, all) & bit(to);
+			break;
+		case PieceType::Rook:
+			valid = rookAttacks(from, all) & bit(to);
+			break;
+		case PieceType::Queen:
+			valid = queenAttacks(from, all) & bit(to);
+			break;
+		case PieceType::King: {
+			bool white = side == Color::White;
+			valid = kingAttacks(from) & bit(to);
+			if (to == from + 2 and (s.castling() & 
+				(white ? State::WhiteKingside : State::BlackKingside))) {
+				valid = !(all & (bit(from + 1) | bit(from + 2)));
+				flags = Move::KingCastle;
+			} else if (to == from - 2 and (s.castling() & 
+				(white ? State::WhiteQueenside : State::BlackQueenside))) {
+				valid = !(all & (bit(from - 1) | bit(from - 2) | bit(from - 3)));
+				flags = Move::QueenCastle;
+			}
+			break;
+		}
+	}
+
+	Move m(from, to, flags);
+	if (!valid or !s.isLegal(m, s.checkInfo(side)))
+		return Move();
+	return m;
+}
+
+Piece* Chessboard::promote(Piece* pawn, const std::type_index& type) {
+	PieceType t;
+	if (!promotionType(type, t))
+		TARTAN_THROW(tt::ex::bad_piece_type());
+	std::vector<Piece*>& spares = c_spares[State::index(pawn->color())][State::index(t) - 1];
+
+	Piece* p;
+	if (spares.empty()) {
+		switch (t) {
+			case PieceType::Knight: p = new Knight; break;
+			case PieceType::Bishop: p = new Bishop; break;
+			case PieceType::Rook: p = new Rook; break;
+			default: p = new Queen; break;
+		}
+		p->setColor(pawn->color());
+	} else {
+		p = spares.back();
+		spares.pop_back();
+	}
+
+	Position pos = pawn->position();
+	removePiece(pos);
+	b_capturedPieces.push_back(pawn);
+	p->setPosition(pos);
+	placePiece(p);
+	return p;
+}
+
+void Chessboard::demote(Piece* pawn) {
+	int t = State::index(c_state.type(square(pawn->position()))) - 1;
+	Piece* p = removePiece(pawn->position());
+	c_spares[State::index(p->color())][t].push_back(p);
+	restoreCaptured(pawn);
+	placePiece(pawn);
 }
 
 void Chessboard::markChecks(TurnMap& tm) const {
 	if (!c_currentKing)
-		throw ex::no_king(b_currentTurnColor);
+		TARTAN_THROW(ex::no_king(b_currentTurnColor));
 
+	Color color = b_currentTurnColor;
+	State::CheckInfo ci = c_state.checkInfo(color);
 	for (auto& t : tm) {
-		(*t).apply(true);
-		(*t).setPossible(!c_currentKing->check());
-		(*t).undo();
+		if (t->piece()->color() != color) {
+			color = t->piece()->color();
+			if (!(c_state.pieces(color, PieceType::King)))
+				TARTAN_THROW(ex::no_king(color));
+			ci = c_state.checkInfo(color);
+		}
+		t->setPossible(c_state.isLegal(move(*t, c_state), ci));
 	}
 }
 
 Piece::Color Chessboard::setCurrentTurn(Piece::Color c) {
 	Piece::Color ret = Board::setCurrentTurn(c);
+	c_state.setSide(c);
 
 	if (b_currentTurnColor == Color::White) {
 		c_currentKing = c_whiteKing;
@@ -149,8 +515,62 @@ Piece::Color Chessboard::setCurrentTurn(Piece::Color c) {
 	return ret;
 }
 
+void Chessboard::piecePlaced(const Piece* p) {
+	Board::piecePlaced(p);
+	PieceType t;
+	if (pieceType(p, t))
+		c_state.put(square(p->position()), p->color(), t);
+}
+
+void Chessboard::pieceRemoved(const Piece* p) {
+	Board::pieceRemoved(p);
+	int sq = square(p->position());
+	if (c_state.occupancy() & bit(sq))
+		c_state.remove(sq);
+}
+
+void Chessboard::pieceMoved(const Piece* p, const Position& from) {
+	Board::pieceMoved(p, from);
+	int sq = square(from);
+	if (c_state.occupancy() & bit(sq))
+		c_state.move(sq, square(p->position()));
+}
+
+void Chessboard::updateCastling() {
+	auto unmoved = [this](int x, int y, Color c, PieceType t) {
+		const Piece* p = at({x, y});
+		return p and p->movesMade() == 0 and p->color() == c and 
+			c_state.type(tt::square(x, y)) == t;
+	};
+
+	int rights = State::NoCastling;
+	if (unmoved(5, 1, Color::White, PieceType::King)) {
+		if (unmoved(8, 1, Color::White, PieceType::Rook))
+			rights |= State::WhiteKingside;
+		if (unmoved(1, 1, Color::White, PieceType::Rook))
+			rights |= State::WhiteQueenside;
+	}
+	if (unmoved(5, 8, Color::Black, PieceType::King)) {
+		if (unmoved(8, 8, Color::Black, PieceType::Rook))
+			rights |= State::BlackKingside;
+		if (unmoved(1, 8, Color::Black, PieceType::Rook))
+			rights |= State::BlackQueenside;
+	}
+	c_state.setCastling(rights);
+}
+
 void Chessboard::clear() {
 	Board::clear();
+	c_state.clear();
+	c_records.clear();
+	c_halfmoveClock = 0;
+	c_fullmoveNumber = 1;
+	for (auto& color : c_spares)
+		for (auto& spares : color) {
+			for (Piece* p : spares)
+				delete p;
+			spares.clear();
+		}
 	c_currentKing = nullptr;
 	c_currentEnemyKing = nullptr;
 	c_blackKing = nullptr;
@@ -202,18 +622,9 @@ std::string Chessboard::str() const {
 			const Piece* p = at({i, j});
 
 			char letter;
-			if (dynamic_cast<const Pawn*>(p))
-				letter = 'p';
-			else if (dynamic_cast<const Knight*>(p))
-				letter = 'n';
-			else if (dynamic_cast<const Bishop*>(p))
-				letter = 'b';
-			else if (dynamic_cast<const Rook*>(p))
-				letter = 'r';
-			else if (dynamic_cast<const Queen*>(p))
-				letter = 'q';
-			else if (dynamic_cast<const King*>(p))
-				letter = 'k';
+			PieceType t;
+			if (p and pieceType(p, t))
+				letter = "pnbrqk"[State::index(t)];
 			else 
 				letter = ((i + j)%2 ? '+' : '#');
 
@@ -229,34 +640,15 @@ std::string Chessboard::str() const {
 }
 
 bool Chessboard::isEqual(const Board& rhs) const {
-	if (!dynamic_cast<const Chessboard*>(&rhs))
+	const Chessboard* crhs = dynamic_cast<const Chessboard*>(&rhs);
+	if (!crhs)
 		return false;
 
-	BoardT::const_iterator lRow = begin();
-	BoardT::const_iterator rRow = rhs.begin();
-	while (lRow != end() and rRow != rhs.end()) {
-		auto lPiece = lRow->begin();
-		auto rPiece = rRow->begin();
-		for ( ; lPiece != lRow->end() and rPiece != rRow->end(); lPiece++, rPiece++) {
-			if (*lPiece == *rPiece)
-				continue;
-			else if (dynamic_cast<Pawn*>(*lPiece) and dynamic_cast<Pawn*>(*rPiece))
-					continue;
-			else if (dynamic_cast<Bishop*>(*lPiece) and dynamic_cast<Bishop*>(*rPiece))
-					continue;
-			else if (dynamic_cast<Knight*>(*lPiece) and dynamic_cast<Knight*>(*rPiece))
-					continue;
-			else if (dynamic_cast<Rook*>(*lPiece) and dynamic_cast<Rook*>(*rPiece))
-					continue;
-			else if (dynamic_cast<Queen*>(*lPiece) and dynamic_cast<Queen*>(*rPiece))
-					continue;
-			else if (dynamic_cast<King*>(*lPiece) and dynamic_cast<King*>(*rPiece))
-					continue;
-			else
-					return false;
-		}
-		lRow++, rRow++;
-	}
+	const State& l = c_state;
+	const State& r = crhs->c_state;
+	for (int t = 0; t < 6; t++)
+		if (l.pieces(PieceType(t)) != r.pieces(PieceType(t)))
+			return false;
 	return true;
 }
 
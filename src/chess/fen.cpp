@@ -0,0 +1,288 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/exceptions.hpp>
+
+#include <charconv>
+
+namespace tt::chess {
+using Color = Piece::Color;
+
+namespace {
+
+const char letters[2][7] = {"pnbrqk", "PNBRQK"};
+
+Color enemy(Color c) {
+	return c == Color::White ? Color::Black : Color::White;
+}
+
+bool has(const State& s, int sq, Color c, PieceType t) {
+	return s.pieces(c, t) & bit(sq);
+}
+
+// next space separated field, empty if there are no more
+std::string_view field(std::string_view& fen) {
+	std::size_t start = fen.find_first_not_of(' ');
+	if (start == std::string_view::npos)
+		return fen = {};
+	fen.remove_prefix(start);
+	std::string_view f = fen.substr(0, fen.find(' '));
+	fen.remove_prefix(f.size());
+	return f;
+}
+
+bool number(std::string_view f, unsigned max, unsigned& n) {
+	const char* end = f.data() + f.size();
+	auto [ptr, ec] = std::from_chars(f.data(), end, n);
+	return ec == std::errc() and ptr == end and n <= max;
+}
+
+bool placement(std::string_view f, State& s) {
+	int x = 1, y = 8;
+	for (char c : f) {
+		if (c == '/') {
+			if (x != 9 or y == 1)
+				return false;
+			x = 1, y--;
+		} else if (c >= '1' and c <= '8') {
+			x += c - '0';
+			if (x > 9)
+				return false;
+		} else {
+			int t = 0;
+			while (t < 6 and c != letters[0][t] and c != letters[1][t])
+				t++;
+			if (t == 6 or x > 8)
+				return false;
+			Color color = c == letters[1][t] ? Color::White : Color::Black;
+			s.put(square(x++, y), color, static_cast<PieceType>(t));
+		}
+	}
+	return x == 9 and y == 1;
+}
+
+bool castling(std::string_view f, State& s) {
+	if (f == "-")
+		return true;
+
+	int rights = State::NoCastling;
+	for (char c : f) {
+		int right, y, rookX;
+		Color color;
+		switch (c) {
+			case 'K': right = State::WhiteKingside, color = Color::White, y = 1, rookX = 8; break;
+			case 'Q': right = State::WhiteQueenside, color = Color::White, y = 1, rookX = 1; break;
+			case 'k': right = State::BlackKingside, color = Color::Black, y = 8, rookX = 8; break;
+			case 'q': right = State::BlackQueenside, color = Color::Black, y = 8, rookX = 1; break;
+			default: return false;
+		}
+		if ((rights & right) or
+			!has(s, square(5, y), color, PieceType::King) or
+			!has(s, square(rookX, y), color, PieceType::Rook))
+			return false;
+		rights |= right;
+	}
+	s.setCastling(rights);
+	return !f.empty();
+}
+
+bool enPassant(std::string_view f, State& s) {
+	if (f == "-")
+		return true;
+	if (f.size() != 2 or f[0] < 'a' or f[0] > 'h')
+		return false;
+
+	// the pawn that has just moved belongs to the enemy of side to move
+	Color moved = enemy(s.side());
+	int forward = moved == Color::White ? 8 : -8;
+	if (f[1] != (moved == Color::White ? '3' : '6'))
+		return false;
+
+	int sq = square(f[0] - 'a' + 1, f[1] - '0');
+	if (!has(s, sq + forward, moved, PieceType::Pawn) or
+		s.occupancy() & (bit(sq) | bit(sq - forward)))
+		return false;
+	s.setEnPassant(sq);
+	return true;
+}
+
+// nullptr if `fen` is valid, reason why it is not otherwise
+const char* parse(std::string_view fen, State& s, unsigned& halfmove, unsigned& fullmove) {
+	if (!placement(field(fen), s))
+		return "Invalid piece placement";
+	for (Color c : {Color::White, Color::Black})
+		if (popcount(s.pieces(c, PieceType::King)) != 1)
+			return "Each side must have one king";
+	if (s.pieces(PieceType::Pawn) & (rank1 | rank8))
+		return "Pawn on the first or last rank";
+	for (Color c : {Color::White, Color::Black})
+		if (!s.hasPossibleMaterial(c))
+			return "Too many pieces";
+
+	std::string_view side = field(fen);
+	if (side != "w" and side != "b")
+		return "Invalid side to move";
+	s.setSide(side == "w" ? Color::White : Color::Black);
+
+	if (!castling(field(fen), s))
+		return "Invalid castling rights";
+	if (!enPassant(field(fen), s))
+		return "Invalid en passant tile";
+
+	halfmove = 0, fullmove = 1;
+	if (std::string_view f = field(fen); !f.empty()) {
+		if (!number(f, 0xFFFF, halfmove))
+			return "Invalid halfmove clock";
+		if (!number(field(fen), 0xFFFF, fullmove) or fullmove == 0)
+			return "Invalid fullmove number";
+	}
+	if (!field(fen).empty())
+		return "Too many fields";
+
+	Color waiting = enemy(s.side());
+	if (s.isSquareAttacked(lsb(s.pieces(waiting, PieceType::King)), s.side()))
+		return "Side that is not to move is in check";
+	return nullptr;
+}
+
+Piece* newPiece(PieceType t) {
+	switch (t) {
+		case PieceType::Pawn: return new Pawn;
+		case PieceType::Knight: return new Knight;
+		case PieceType::Bishop: return new Bishop;
+		case PieceType::Rook: return new Rook;
+		case PieceType::Queen: return new Queen;
+		default: return new King;
+	}
+}
+
+}
+
+void Chessboard::fromFEN(std::string_view fen) {
+	State s;
+	unsigned halfmove, fullmove;
+	const char* error = parse(fen, s, halfmove, fullmove);
+	if (error)
+		TARTAN_THROW(ex::bad_fen(error));
+	load(s, halfmove, fullmove);
+}
+
+Status Chessboard::tryFromFEN(std::string_view fen) {
+	State s;
+	unsigned halfmove, fullmove;
+	if (parse(fen, s, halfmove, fullmove))
+		return Status::BadFen;
+	load(s, halfmove, fullmove);
+	return Status::Ok;
+}
+
+void Chessboard::load(const State& s, int halfmove, std::size_t fullmove) {
+	clear();
+	Bitboard occupied = s.occupancy();
+	while (occupied) {
+		int sq = popLsb(occupied);
+		Piece* p = newPiece(s.type(sq));
+		p->setColor(s.color(sq));
+		p->setPosition({squareX(sq), squareY(sq)});
+		insertPiece(p);
+	}
+
+	int castling = s.castling();
+	for (Color c : {Color::White, Color::Black}) {
+		bool white = c == Color::White;
+		int kingside = castling & (white ? State::WhiteKingside : State::BlackKingside);
+		int queenside = castling & (white ? State::WhiteQueenside : State::BlackQueenside);
+		for (Piece* p : pieces(c)) {
+			int x = p->position().x(), y = p->position().y();
+			bool moved = false;
+			switch (s.type(square(x, y))) {
+				case PieceType::Pawn:
+					moved = y != (white ? 2 : 7);
+					break;
+				case PieceType::King:
+					moved = !kingside and !queenside;
+					break;
+				case PieceType::Rook:
+					moved = !(y == (white ? 1 : 8) and
+						((x == 8 and kingside) or (x == 1 and queenside)));
+					break;
+				default:
+					break;
+			}
+			if (moved)
+				p->setMovesMade(1);
+		}
+	}
+
+	// the pawn capturable en passant has made the last turn
+	if (int ep = s.enPassant(); ep >= 0) {
+		b_turnIndex = 1;
+		int pawn = ep + (s.side() == Color::White ? -8 : 8);
+		at({squareX(pawn), squareY(pawn)})->setMovesMade(1, b_turnIndex);
+	}
+
+	setCurrentTurn(s.side());
+	updateCastling();
+	c_state.setEnPassant(s.enPassant());
+	c_halfmoveClock = static_cast<std::uint16_t>(halfmove);
+	c_fullmoveNumber = fullmove;
+}
+
+std::size_t Chessboard::fullmoveNumber() const {
+	std::size_t plies = movesMade();
+	// history started with the turn of Black
+	bool black = (b_currentTurnColor == Color::Black) != (plies % 2 == 1);
+	return c_fullmoveNumber + (plies + black)/2;
+}
+
+std::size_t Chessboard::toFEN(char* buf) const {
+	char* out = buf;
+	for (int y = 8; y >= 1; y--) {
+		char empty = '0';
+		for (int x = 1; x <= 8; x++) {
+			int sq = square(x, y);
+			if (!(c_state.occupancy() & bit(sq))) {
+				empty++;
+				continue;
+			}
+			if (empty != '0')
+				*out++ = empty, empty = '0';
+			*out++ = letters[State::index(c_state.color(sq))][State::index(c_state.type(sq))];
+		}
+		if (empty != '0')
+			*out++ = empty;
+		if (y > 1)
+			*out++ = '/';
+	}
+
+	*out++ = ' ';
+	*out++ = b_currentTurnColor == Color::White ? 'w' : 'b';
+
+	*out++ = ' ';
+	int castling = c_state.castling();
+	if (castling & State::WhiteKingside)
+		*out++ = 'K';
+	if (castling & State::WhiteQueenside)
+		*out++ = 'Q';
+	if (castling & State::BlackKingside)
+		*out++ = 'k';
+	if (castling & State::BlackQueenside)
+		*out++ = 'q';
+	if (castling == State::NoCastling)
+		*out++ = '-';
+
+	*out++ = ' ';
+	if (int ep = c_state.enPassant(); ep >= 0) {
+		*out++ = static_cast<char>('a' + squareX(ep) - 1);
+		*out++ = static_cast<char>('0' + squareY(ep));
+	} else {
+		*out++ = '-';
+	}
+
+	*out++ = ' ';
+	out = std::to_chars(out, buf + fenSize, c_halfmoveClock).ptr;
+	*out++ = ' ';
+	out = std::to_chars(out, buf + fenSize, fullmoveNumber()).ptr;
+	*out = '\0';
+	return static_cast<std::size_t>(out - buf);
+}
+
+}
@@ -2,6 +2,14 @@
 #define _TARTAN_CHESS_HPP_
 
 #include <tartan/board.hpp>
+#include <tartan/board/exceptions.hpp>
+#include <tartan/chess/state.hpp>
+#include <tartan/chess/packed.hpp>
+
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 //! Chess game namespace
 namespace tt::chess {
@@ -22,23 +30,54 @@ class King;
 class Chessboard : public Board {
 public:
 	using Board::Board;
+	//! Destruct Chessboard, spare promotion pieces included
+	~Chessboard();
 	/**
 	 * @brief Make turn on Chessboard
 	 *
-	 * Function calls the Board::produceTurn() function, 
-	 * then it validates for the checks with markChecks(). If 
-	 * the move cannot be performed, corresponding exception 
-	 * is thrown.
+	 * The single requested move is validated first with 
+	 * findMove(): its geometry and path are checked on the 
+	 * state() bitboards and the King safety with one 
+	 * State::isLegal() call. Only if that fails, function calls 
+	 * the Board::produceTurn() function, then it validates 
+	 * for the checks with markChecks(), so the corresponding
+	 * exception is thrown if the move cannot be performed. 
+	 * Pawn promotion piece is selected with
+	 * Board::getPieceType().
 	 *
 	 * @param from Position at which the moving Piece is located.
 	 * @param to Position at which moving Piece will end up
-	 * @return applied Piece::Turn object if everything went okay
+	 * @return applied Piece::Turn object if everything went okay,
+	 * the copy kept in Board::history()
 	 * @exception ex::check if c_currentKing King::check()
 	 * will return `true` after this move.
 	 * @exception ex::checkmate if c_currentKing is under checkmate.
+	 * @exception tt::ex::bad_piece_type if the piece getter 
+	 * returned a type it was not offered
+	 * @sa tryMakeTurn()
 	 */
 	virtual const Piece::Turn* makeTurn(const Piece::Position& from, 
 																		 const Piece::Position& to) override;
+	/**
+	 * @brief Make turn on Chessboard without exceptions
+	 *
+	 * Same as makeTurn(), but every error is reported with 
+	 * returned Status, so rejecting the illegal move costs
+	 * neither exception unwinding nor message strings.
+	 * Chessboard is not changed unless Status::Ok is returned.
+	 *
+	 * @param from Position at which the moving Piece is located.
+	 * @param to Position at which moving Piece will end up
+	 * @param[out] turn if not `nullptr`, set to the applied 
+	 * Piece::Turn object on Status::Ok
+	 * @return Status::Ok, Board::tryProduceTurn() errors, 
+	 * Status::NoKing, Status::Check, Status::Checkmate or
+	 * Status::NoPieceGetter if the promotion piece can not be
+	 * selected or Status::BadPieceType if the piece getter 
+	 * returned a type it was not offered
+	 */
+	Status tryMakeTurn(const Piece::Position& from, const Piece::Position& to,
+										 const Piece::Turn** turn = nullptr);
 	/**
 	 * @copybrief tt::Board::piece()
 	 *
@@ -68,18 +107,41 @@ public:
 	 * `spec` description
 	 */
 	virtual Piece* piece(const std::string& spec) const override;
+	/**
+	 * @copybrief tt::Board::tryPiece()
+	 *
+	 * Parses the piece() `spec` without exceptions.
+	 *
+	 * @param spec string represeantation of chess Piece
+	 * @return newly allocated Piece object or `nullptr`
+	 */
+	virtual Piece* tryPiece(const std::string& spec) const override;
 	/**
 	 * @copybrief Board::canInsert()
 	 *
 	 * Checks if the inserted Piece is a King object. 
 	 * If it is, then checks that Chessboard does not
-	 * already have a King of that color.
+	 * already have a King of that color. Then checks
+	 * that the side still has material a game can have
+	 * with State::hasPossibleMaterial(), so the moves
+	 * of every position fit into MoveList.
 	 *
 	 * @copydetails Board::canInsert()
 	 * @exception ex::duplicate_king inserted King witch such
 	 * color already present
+	 * @exception ex::too_many_pieces side of inserted
+	 * piece has too many pieces with it
 	 */
 	virtual Piece* canInsert(Piece* p) const override;
+	/**
+	 * @copybrief tt::Board::checkInsert()
+	 *
+	 * @param p checked Piece object
+	 * @return tt::Board::checkInsert() result,
+	 * Status::DuplicateKing or Status::TooManyPieces
+	 * @sa canInsert()
+	 */
+	virtual Status checkInsert(const Piece* p) const override;
 	/**
 	 * @copybrief tt::Board::insertPiece()
 	 *
@@ -92,6 +154,8 @@ public:
 	 * @return inserted piece object
 	 * @exception ex::duplicate_king `p` is a King object 
 	 * of color and king of that color already been set
+	 * @exception ex::too_many_pieces side of `p` has
+	 * too many pieces with it
 	 */
 	virtual Piece* insertPiece(Piece* p) override;
 	/**
@@ -130,6 +194,299 @@ public:
 	 */
 	virtual Piece::TurnMap possibleMoves(const Piece*) const override;
 	using Board::possibleMoves;
+	/**
+	 * @copybrief Board::applyTurn()
+	 *
+	 * Updates castling rights and en passant tile of c_state
+	 * after the turn is applied.
+	 * @copydetails Board::applyTurn()
+	 */
+	virtual const Piece::Turn* applyTurn(Piece::Turn* turn) override;
+	/**
+	 * @copybrief Board::undoTurn()
+	 *
+	 * Castling rights, en passant tile and halfmove clock
+	 * are restored from the Record saved by applyTurn(),
+	 * promoted pawn replaces its promotion piece. Takes 
+	 * constant time.
+	 * @copydetails Board::undoTurn()
+	 */
+	virtual const Piece::Turn* undoTurn() override;
+	/**
+	 * @brief Replace Pawn with the promotion piece
+	 *
+	 * Promotion piece is taken from the spare pieces 
+	 * returned by demote(), new Piece object is allocated 
+	 * only if there is no spare Piece of that type and color. 
+	 * The Pawn is moved to the captured pieces.
+	 *
+	 * Used by Pawn::Turn::apply().
+	 *
+	 * @param pawn Pawn on the top tile
+	 * @param type promotion piece type
+	 * @return promotion piece
+	 * @exception tt::ex::bad_piece_type if `type` is not 
+	 * Queen, Rook, Bishop or Knight
+	 */
+	Piece* promote(Piece* pawn, const std::type_index& type);
+	/**
+	 * @brief Take back the promotion
+	 *
+	 * Promotion piece at `pawn` position is moved to the 
+	 * spare pieces and the `pawn` is put back on Board.
+	 *
+	 * Used by Pawn::Turn::undo().
+	 *
+	 * @param pawn promoted Pawn
+	 */
+	void demote(Piece* pawn);
+	/**
+	 * @brief Halfmove clock
+	 *
+	 * Count of turns since the last capture or Pawn move, 
+	 * used by the fifty-move rule.
+	 *
+	 * @return halfmove clock value
+	 */
+	int halfmoveClock() const { return c_halfmoveClock; };
+	/**
+	 * @brief Fullmove number
+	 *
+	 * Starts at 1 and is incremented after every 
+	 * turn of Black.
+	 *
+	 * @return fullmove number
+	 */
+	std::size_t fullmoveNumber() const;
+	/**
+	 * @brief Load position from FEN string
+	 *
+	 * Clears the Chessboard and fills it with the position 
+	 * described in Forsyth-Edwards Notation: pieces, side 
+	 * to move, castling rights, en passant tile and 
+	 * both clocks. Clock fields can be omitted, then
+	 * halfmove clock is 0 and fullmove number is 1.
+	 *
+	 * Input is validated before Chessboard is changed:
+	 * each side must have one King and at most 16 pieces,
+	 * pieces above the initial set need as many missing Pawns
+	 * they could be promoted from, no Pawn can stand on
+	 * the first or last rank, castling rights need King and
+	 * Rook at their initial tiles, en passant tile needs the 
+	 * Pawn that has just moved over it and side that is
+	 * not to move must not be in check.
+	 *
+	 * Pieces are marked as moved with Piece::setMovesMade(), so 
+	 * Piece::moveMap() follows the loaded position: Pawns out of 
+	 * their initial rank, Kings without castling rights,
+	 * Rooks without castling rights have moved; the
+	 * Pawn that can be captured en passant has just moved.
+	 *
+	 * @param fen FEN string
+	 * @exception ex::bad_fen if `fen` is invalid,
+	 * Chessboard is not changed then
+	 * @sa tryFromFEN(), toFEN()
+	 */
+	void fromFEN(std::string_view fen);
+	/**
+	 * @brief Load position from FEN string without exceptions
+	 *
+	 * @copydetails fromFEN()
+	 * @return Status::Ok or Status::BadFen
+	 */
+	Status tryFromFEN(std::string_view fen);
+	/**
+	 * @brief Write current position as FEN string
+	 *
+	 * Nothing is allocated, string is written straight 
+	 * to `buf`.
+	 *
+	 * @param[out] buf buffer at least fenSize characters long
+	 * @return length of the null-terminated string written to `buf`
+	 * @sa fromFEN()
+	 */
+	std::size_t toFEN(char* buf) const;
+	//! Buffer size enough for any toFEN() string
+	static constexpr std::size_t fenSize = 128;
+	/**
+	 * @brief Load position from PackedState
+	 *
+	 * Clears the Chessboard and fills it with the packed
+	 * pieces, side to move, castling rights, en passant
+	 * tile and clocks. Pieces are marked as moved the 
+	 * same way fromFEN() marks them.
+	 *
+	 * @param p position packed with toPacked()
+	 * @sa toPacked()
+	 */
+	void fromPacked(const PackedState& p);
+	/**
+	 * @brief Pack current position
+	 *
+	 * @return PackedState with the position and clocks,
+	 * move history is not kept
+	 * @sa fromPacked()
+	 */
+	PackedState toPacked() const;
+	/**
+	 * @brief Find legal move written in Standard Algebraic Notation
+	 *
+	 * Accepts the piece letter, file and rank disambiguation,
+	 * capture mark, destination tile, promotion with or
+	 * without `=`, castling with letters `O` or digits `0`
+	 * and trailing check and annotation marks, eq. `e4`,
+	 * `Nbd7`, `R1xa3`, `exd6`, `e8=Q+`, `O-O-O`, `Qh5!?`.
+	 * Capture mark is not verified.
+	 *
+	 * Move is matched against the legal moves of the
+	 * side to move, generated once with State::generateLegal(),
+	 * nothing is allocated.
+	 *
+	 * @param san move string
+	 * @param[out] move found Move, the null Move on error
+	 * @return Status::Ok, Status::BadSan if `san` is malformed,
+	 * Status::NoSuchMove if no legal move matches it,
+	 * Status::AmbiguousMove if several do or Status::NoKing
+	 * if the King of the side to move is absent
+	 * @sa applyMove()
+	 */
+	Status findSAN(std::string_view san, Move& move) const;
+	/**
+	 * @brief Apply legal Move of the side to move
+	 *
+	 * Faster than makeTurn() when the Move is known to be
+	 * legal, eq. found with findMove(), findSAN() or
+	 * legalMoves(): nothing is validated, the Turn object
+	 * is built with turns() and applied with applyTurn().
+	 * Promotion piece is taken from the Move, the piece
+	 * getter is not called.
+	 *
+	 * @param m legal Move
+	 * @return applied Piece::Turn object, the copy kept in
+	 * Board::history()
+	 */
+	const Piece::Turn* applyMove(Move m);
+	/**
+	 * @brief Check if a tile is attacked
+	 *
+	 * Answered from the state() bitboards by casting 
+	 * the attacks of every piece type from `pos`.
+	 *
+	 * @param pos tile Position
+	 * @param by attacking pieces color
+	 * @return `true` if any Piece of `by` color attacks `pos`
+	 * @sa State::isSquareAttacked()
+	 */
+	bool isSquareAttacked(const Piece::Position& pos, Piece::Color by) const;
+	/**
+	 * @brief Pieces that attack a tile
+	 *
+	 * @param pos tile Position
+	 * @return Bitboard of pieces of both colors that attack `pos`
+	 * @sa State::attackersOf()
+	 */
+	Bitboard attackersOf(const Piece::Position& pos) const;
+	/**
+	 * @brief Legal moves of the side to move
+	 *
+	 * Every legal move of the currentTurn() pieces in one call.
+	 * Moves are generated from the state() with 
+	 * State::generateLegal(), so pins, checkers and check 
+	 * evasion tiles are computed once for the whole side 
+	 * instead of running markChecks() for every piece.
+	 * Function does not allocate memory.
+	 *
+	 * @param[out] list buffer to append moves to
+	 * @exception ex::no_king if the King is absent
+	 * @sa turns()
+	 */
+	void legalMoves(MoveList& list) const { legalMoves(list, b_currentTurnColor); };
+	/**
+	 * @brief Legal moves of some color
+	 *
+	 * @copydetails legalMoves(MoveList&) const
+	 * @param c color of moving pieces
+	 */
+	void legalMoves(MoveList& list, Piece::Color c) const;
+	/**
+	 * @brief Turn objects for the moves
+	 *
+	 * Adapter for the code that works with Piece::Turn
+	 * objects. Moves are usually produced with
+	 * State::generate() from the state(). Every Move is 
+	 * mapped to the Turn object of the moving piece type,
+	 * castling moves get the Rook::Turn attached. Pawn
+	 * promotion piece is selected by the piece getter when
+	 * the Turn is applied, as usual.
+	 *
+	 * @param list moves of the current position
+	 * @return TurnMap with Turn object for every move in `list`
+	 */
+	Piece::TurnMap turns(const MoveList& list) const;
+	/**
+	 * @brief Copy of the Chessboard
+	 *
+	 * Every Piece is copied together with its turn counters,
+	 * so the copy has the same castling rights, en passant
+	 * tile and turn color and is completely independent of 
+	 * the original. History and captured pieces are not 
+	 * copied unless requested, as most of the analysis does 
+	 * not need them.
+	 *
+	 * For searching the position on many threads prefer the
+	 * state() snapshot: State is a trivially copyable value
+	 * that is copied with a single `memcpy`.
+	 *
+	 * @param history copy history, captured pieces and 
+	 * undoTurn() records too
+	 * @return newly allocated Chessboard
+	 * @sa Board::copyTo()
+	 */
+	std::unique_ptr<Chessboard> clone(bool history = false) const;
+	/**
+	 * @brief Type returned by perftDivide()
+	 *
+	 * List of pairs of root move string in Move::str()
+	 * form (eq. `e2e4`, `e7e8q`) and count of leaf nodes 
+	 * reached through that move.
+	 */
+	using PerftDivideT = std::list<std::pair<std::string, std::uint64_t>>;
+	/**
+	 * @brief Count leaf nodes of legal move tree
+	 *
+	 * Walks every sequence of `depth` legal turns
+	 * from the current position and counts them. 
+	 * Turns are generated with Piece::moveMap(), validated 
+	 * with markChecks() and applied with Turn::apply() and 
+	 * Turn::undo(), so the result is both the move generator
+	 * correctness check and its throughput benchmark. 
+	 * The position is restored when function returns.
+	 *
+	 * Positions that were already counted could be looked up
+	 * in the transposition table of `hashSize` MiB, which 
+	 * speeds up deep runs a lot. Table is not used if 
+	 * `hashSize` is 0.
+	 *
+	 * Every promotion piece type is a separate turn, 
+	 * promotions are made with the spare pieces, so 
+	 * they do not allocate.
+	 *
+	 * @param depth tree depth
+	 * @param hashSize transposition table size in MiB
+	 * @return count of leaf nodes
+	 * @exception ex::no_king if current King is not present
+	 * @sa perftDivide()
+	 */
+	std::uint64_t perft(int depth, std::size_t hashSize = 0);
+	/**
+	 * @brief Count leaf nodes of legal move tree for 
+	 * every root move
+	 *
+	 * @copydetails perft()
+	 * @return count of leaf nodes for each root move
+	 * @sa perft()
+	 */
+	PerftDivideT perftDivide(int depth, std::size_t hashSize = 0);
 
 	/**
 	 * @brief Current White King
@@ -175,6 +532,28 @@ public:
 	 * @copydoc currentEnemyKing() const
 	 */
 	King* currentEnemyKing() { return c_currentEnemyKing; };
+	/**
+	 * @brief Bitboard representation of current position
+	 *
+	 * State object is updated incrementally with
+	 * every Piece placement, move and capture.
+	 *
+	 * @return current State object
+	 * @sa c_state
+	 */
+	const State& state() const { return c_state; };
+	/**
+	 * @brief Zobrist hash of current position
+	 *
+	 * Constant time position identity, that is kept up 
+	 * to date by every Turn::apply(), Turn::undo(), Piece 
+	 * placement and clear(). Castling rights and en passant
+	 * tile are updated by applyTurn().
+	 *
+	 * @return 64-bit position key
+	 * @sa State::hash()
+	 */
+	std::uint64_t hash() const { return c_state.hash(); };
 	/**
 	 * @brief Get default chessboard Piece set
 	 *
@@ -233,8 +612,9 @@ public:
 		 * King movemap when trying to figure
 		 * out should it perform castling or not.
 		 *
-		 * Also the Pawn promption move uses it to 
-		 * not promote pawn and just move it to the 
+		 * Also the Pawn promption Turn without 
+		 * Pawn::Turn::promoteTo() uses it to not ask for 
+		 * the piece type and just move the pawn to the 
 		 * top of board, because when checking for King 
 		 * checks we don't care about exchange piece type.
 		 */
@@ -243,13 +623,136 @@ public:
 protected:
 	/**
 	 * @brief Marks Tunr objects that 
-	 * will put current King in check
+	 * will put their King in check
+	 *
+	 * Turns are not applied: State::checkInfo() pinned pieces
+	 * and check evasion tiles are computed once and every
+	 * Turn is validated with State::isLegal().
 	 *
 	 * @param[in,out] map input TurnMap of Turn objects
 	 * to check if they lead to check
+	 * @exception ex::no_king if current King or King of 
+	 * Turn piece color is not present
 	 */
 	void markChecks(Piece::TurnMap& map) const;
+	/**
+	 * @brief Find legal move of the side to move
+	 *
+	 * Checks only the requested move: the moving piece
+	 * attacks or pawn push geometry, empty path and 
+	 * castling rights on the state() bitboards, then
+	 * State::isLegal(). Promotion moves are returned with
+	 * the Move::QueenPromotion flag.
+	 *
+	 * Moves allowed only by the Piece::moveMap() rules 
+	 * that State does not follow are not found.
+	 *
+	 * @param from source tile index
+	 * @param to destination tile index
+	 * @return legal Move or the null Move
+	 */
+	Move findMove(int from, int to) const;
+	//! Transposition table used by perft()
+	class PerftTable;
+	/**
+	 * @brief Recursive perft() implementation
+	 *
+	 * @param depth remaining depth, > 0
+	 * @param table transposition table or `nullptr`
+	 * @param[out] divide per root move counts or `nullptr`
+	 * @return count of leaf nodes
+	 */
+	std::uint64_t perft(int depth, PerftTable* table, PerftDivideT* divide);
+	/**
+	 * @brief Position key used by PerftTable
+	 *
+	 * Besides the hash() of the position, covers 
+	 * everything that influences Piece::moveMap(): 
+	 * pieces that have not moved yet (castling and 
+	 * double pawn moves), pawns capturable en passant.
+	 *
+	 * @return 64-bit position key
+	 */
+	std::uint64_t perftKey() const;
+	/**
+	 * @brief Recalculate c_state castling rights
+	 *
+	 * King may castle with the Rook if both of them are
+	 * at their initial tiles and have not made any turns.
+	 */
+	void updateCastling();
+	/**
+	 * @brief Replace position with `s`
+	 *
+	 * Used by fromFEN() and fromPacked().
+	 *
+	 * @param s valid position
+	 * @param halfmove halfmove clock value
+	 * @param fullmove fullmove number value
+	 */
+	void load(const State& s, int halfmove, std::size_t fullmove);
+	/**
+	 * @copybrief Board::piecePlaced()
+	 *
+	 * Puts `p` to c_state.
+	 * @copydetails Board::piecePlaced()
+	 */
+	virtual void piecePlaced(const Piece* p) override;
+	/**
+	 * @copybrief Board::pieceRemoved()
+	 *
+	 * Removes `p` from c_state.
+	 * @copydetails Board::pieceRemoved()
+	 */
+	virtual void pieceRemoved(const Piece* p) override;
+	/**
+	 * @copybrief Board::pieceMoved()
+	 *
+	 * Moves `p` in c_state.
+	 * @copydetails Board::pieceMoved()
+	 */
+	virtual void pieceMoved(const Piece* p, const Piece::Position& from) override;
 protected:
+	/**
+	 * @brief Irreversible part of the position
+	 *
+	 * Saved by applyTurn() for every applied Turn and 
+	 * restored by undoTurn(). The captured Piece is kept by
+	 * the history Turn object itself.
+	 */
+	struct Record {
+		//! State::castling() before the Turn
+		std::uint8_t castling;
+		//! State::enPassant() before the Turn
+		std::int8_t enPassant;
+		//! halfmoveClock() before the Turn
+		std::uint16_t halfmoveClock;
+	};
+	/**
+	 * @brief Record of every Turn in history()
+	 *
+	 * @sa undoTurn()
+	 */
+	std::vector<Record> c_records;
+	/**
+	 * @brief Halfmove clock
+	 *
+	 * @sa halfmoveClock()
+	 */
+	std::uint16_t c_halfmoveClock = 0;
+	/**
+	 * @brief Fullmove number before the first history() Turn
+	 *
+	 * @sa fullmoveNumber()
+	 */
+	std::size_t c_fullmoveNumber = 1;
+	/**
+	 * @brief Spare promotion pieces
+	 *
+	 * Indexed by Piece::Color and PieceType (Knight to Queen).
+	 * @sa promote(), demote()
+	 */
+	std::vector<Piece*> c_spares[2][4];
 	/**
 	 * @brief White King object 
 	 *
@@ -280,12 +783,27 @@ protected:
 	 * @sa currentEnemyKing()
 	 */
 	King* c_currentEnemyKing = nullptr;
+	/**
+	 * @brief Bitboard representation of the Chessboard
+	 *
+	 * @sa state()
+	 */
+	State c_state;
 };
 
  //! @brief Pawn chess Piece
 class Pawn : public Piece {
 public: 
-	using Piece::Piece;
+	/**
+	 * @brief Construct new Pawn
+	 *
+	 * Piece::type() is set to PieceType::Pawn.
+	 *
+	 * @param pos Pawn Position
+	 * @param col Pawn Color
+	 */
+	Pawn(const Position& pos = {1,1}, Color col = Color::White) :
+		Piece(pos, col, static_cast<int>(PieceType::Pawn)) {};
 	/**
 	 * @brief Moves of a Pawn object 
 	 *
@@ -298,10 +816,29 @@ public:
 	 * @brief Pawn Turn
 	 *
 	 * Accomodates Piece::Turn for Pawn promotion logic.
+	 * Every promotion piece type is a separate Turn, 
+	 * promotion is made with Chessboard::promote() and 
+	 * taken back with Chessboard::demote().
 	 */
 	class Turn : public Piece::Turn {
 	public:
 		using Piece::Turn::Turn;
+		/**
+		 * @brief Make new promotion Turn
+		 *
+		 * @param f Pawn that performs the move
+		 * @param t target Turn Position on the top tile
+		 * @param c captured Piece
+		 * @param promoteTo promotion Piece type
+		 * @param p Turn::t_possibe value
+		 */
+		Turn(
+			const Piece* f,
+			const Position& t,
+			const Piece* c,
+			const std::type_index& promoteTo,
+			bool p = true
+		) : Piece::Turn(f, t, c, p), t_promoteTo(promoteTo) {};
 	private:
 		std::type_index t_promoteTo = typeid(nullptr);
 	public:
@@ -310,19 +847,38 @@ public:
 		/**
 		 * @brief Get prometion Piece type
 		 *
-		 * Used on Pawn promotion Turn
+		 * Used on Pawn promotion Turn. If Turn was 
+		 * constructed without the type, apply() 
+		 * asks for it with Board::getPieceType().
 		 *
 		 * @return type of Piece that that the Pawn 
-		 * were promoted to
+		 * is promoted to, `typeid(nullptr)` if Turn 
+		 * is not a promotion
 		 */
 		const std::type_index& promoteTo() const { return t_promoteTo; };
+		/**
+		 * @brief Undo Pawn Turn
+		 *
+		 * Promotion is taken back with Chessboard::demote().
+		 */
+		virtual void undo() override;
+		virtual Turn* clone() const override;
 	};
 };
 
  //! @brief Knight chess Piece
 class Knight : public Piece {
 public: 
-	using Piece::Piece;
+	/**
+	 * @brief Construct new Knight
+	 *
+	 * Piece::type() is set to PieceType::Knight.
+	 *
+	 * @param pos Knight Position
+	 * @param col Knight Color
+	 */
+	Knight(const Position& pos = {1,1}, Color col = Color::White) :
+		Piece(pos, col, static_cast<int>(PieceType::Knight)) {};
 	virtual TurnMap moveMap(int mode = 0) const override;
 	/**
 	 * @brief Knight Turn 
@@ -336,13 +892,23 @@ public:
 		using Piece::Turn::Turn;
 	public:
 		bool isEqual(const Piece::Turn &) const override;
+		virtual Turn* clone() const override;
 	};
 };
 
  //! @brief Bishop chess Piece
 class Bishop : public Piece {
 public: 
-	using Piece::Piece;
+	/**
+	 * @brief Construct new Bishop
+	 *
+	 * Piece::type() is set to PieceType::Bishop.
+	 *
+	 * @param pos Bishop Position
+	 * @param col Bishop Color
+	 */
+	Bishop(const Position& pos = {1,1}, Color col = Color::White) :
+		Piece(pos, col, static_cast<int>(PieceType::Bishop)) {};
 	virtual TurnMap moveMap(int mode = 0) const override;
 	/**
 	 * @brief Bishop Turn
@@ -354,13 +920,23 @@ public:
 		using Piece::Turn::Turn;
 	public:
 		bool isEqual(const Piece::Turn &) const override;
+		virtual Turn* clone() const override;
 	};
 };
 
  //! @brief Rook chess Piece
 class Rook : public Piece {
 public: 
-	using Piece::Piece;
+	/**
+	 * @brief Construct new Rook
+	 *
+	 * Piece::type() is set to PieceType::Rook.
+	 *
+	 * @param pos Rook Position
+	 * @param col Rook Color
+	 */
+	Rook(const Position& pos = {1,1}, Color col = Color::White) :
+		Piece(pos, col, static_cast<int>(PieceType::Rook)) {};
 	virtual TurnMap moveMap(int mode = 0) const override;
 	/**
 	 * @brief Rook Turn
@@ -372,13 +948,23 @@ public:
 		using Piece::Turn::Turn;
 	public:
 		bool isEqual(const Piece::Turn &) const override;
+		virtual Turn* clone() const override;
 	};
 };
 
  //! @brief Queen chess Piece
 class Queen : public Piece {
 public: 
-	using Piece::Piece;
+	/**
+	 * @brief Construct new Queen
+	 *
+	 * Piece::type() is set to PieceType::Queen.
+	 *
+	 * @param pos Queen Position
+	 * @param col Queen Color
+	 */
+	Queen(const Position& pos = {1,1}, Color col = Color::White) :
+		Piece(pos, col, static_cast<int>(PieceType::Queen)) {};
 	virtual TurnMap moveMap(int mode = 0) const override;
 	/**
 	 * @brief Queen Turn
@@ -390,13 +976,23 @@ public:
 		using Piece::Turn::Turn;
 	public:
 		bool isEqual(const Piece::Turn &) const override;
+		virtual Turn* clone() const override;
 	};
 };
 
  //! @brief King chess Piece
 class King : public Piece {
 public: 
-	using Piece::Piece;
+	/**
+	 * @brief Construct new King
+	 *
+	 * Piece::type() is set to PieceType::King.
+	 *
+	 * @param pos King Position
+	 * @param col King Color
+	 */
+	King(const Position& pos = {1,1}, Color col = Color::White) :
+		Piece(pos, col, static_cast<int>(PieceType::King)) {};
 	virtual TurnMap moveMap(int mode = 0) const override;
 	/**
 	 * @brief King Turn
@@ -426,11 +1022,22 @@ public:
 		) : Piece::Turn(f, t, c, p) { 
 			k_castlingTurn = castling;
 		};
+		/**
+		 * @brief Copy constructor
+		 *
+		 * Castling Rook Turn is copied too.
+		 */
+		Turn(const Turn& t) : Piece::Turn(t) {
+			k_castlingTurn = t.k_castlingTurn ? t.k_castlingTurn->clone() : nullptr;
+		};
+		Turn& operator=(const Turn&) = delete;
 	public:
 		bool isEqual(const Piece::Turn &) const override;
 		virtual void apply(int mode = 0) override;
 		virtual void undo() override;
 		virtual std::string str() const override;
+		virtual Turn* clone() const override;
+		virtual void relink(const std::function<Piece*(const Piece*)>& map) override;
 		virtual ~Turn() override {
 			delete k_castlingTurn;
 		}
@@ -460,15 +1067,92 @@ public:
 	 */
 	bool castled() const { return k_castled; };
 private:
-	bool calculateCheck() const;
 	bool calculateCheckmate() const;
 	bool k_castled = false;
-	mutable bool k_check = false;
 	mutable bool k_checkmate = false;
-	mutable std::size_t k_checkTurnIndex = -1;
-	mutable std::size_t k_checkmateTurnIndex = -1;
+	mutable bool k_checkmateKnown = false;
+	mutable std::uint64_t k_checkmateHash = 0;
 };
 
+/**
+ * @brief Chess type of the Piece
+ *
+ * Read from the Piece::type() tag, so RTTI is not used.
+ *
+ * @param p chess Piece
+ * @param[out] t type of `p`
+ * @return `false` if `p` is not a chess Piece
+ */
+inline bool pieceType(const Piece* p, PieceType& t) {
+	if (p->type() < 0 or p->type() > State::index(PieceType::King))
+		return false;
+	t = static_cast<PieceType>(p->type());
+	return true;
+}
+
+/**
+ * @brief Class of promotion piece type
+ *
+ * Maps Move::promoteTo() to the Pawn::Turn::promoteTo() form.
+ *
+ * @param t PieceType::Knight, PieceType::Bishop,
+ * PieceType::Rook or PieceType::Queen
+ * @return `typeid` of the chess Piece class of `t`
+ */
+std::type_index promotionType(PieceType t);
+
+/**
+ * @brief Promotion piece type of class
+ *
+ * Maps Pawn::Turn::promoteTo() to the Move::promoteTo() form.
+ *
+ * @param type `typeid` of a chess Piece class
+ * @param[out] t promotion piece type
+ * @return `false` if `type` is not Knight, Bishop,
+ * Rook or Queen
+ */
+bool promotionType(const std::type_index& type, PieceType& t);
+
+/**
+ * @brief Call functor with the Piece of its chess class
+ *
+ * Type switch over the Piece::type() tag, that replaces 
+ * the chains of `dynamic_cast`. For example, copy of any 
+ * chess Piece is made with
+ * ```
+ * Piece* copy = visit(p, [](const auto* q) -> Piece* {
+ * 	return new std::decay_t<decltype(*q)>(*q);
+ * });
+ * ```
+ *
+ * @tparam P Piece or `const Piece`
+ * @tparam F functor type
+ * @param p chess Piece
+ * @param f functor callable with the pointer to every
+ * chess Piece class, with the constness of `P`
+ * @return `f` result
+ * @exception tt::ex::bad_piece_type if `p` is not a chess Piece
+ */
+template<class P, class F>
+decltype(auto) visit(P* p, F&& f) {
+	constexpr bool c = std::is_const_v<P>;
+	switch (p->type()) {
+		case static_cast<int>(PieceType::Pawn):
+			return f(static_cast<std::conditional_t<c, const Pawn, Pawn>*>(p));
+		case static_cast<int>(PieceType::Knight):
+			return f(static_cast<std::conditional_t<c, const Knight, Knight>*>(p));
+		case static_cast<int>(PieceType::Bishop):
+			return f(static_cast<std::conditional_t<c, const Bishop, Bishop>*>(p));
+		case static_cast<int>(PieceType::Rook):
+			return f(static_cast<std::conditional_t<c, const Rook, Rook>*>(p));
+		case static_cast<int>(PieceType::Queen):
+			return f(static_cast<std::conditional_t<c, const Queen, Queen>*>(p));
+		case static_cast<int>(PieceType::King):
+			return f(static_cast<std::conditional_t<c, const King, King>*>(p));
+	}
+	TARTAN_THROW(tt::ex::bad_piece_type());
+}
+
 }
 
 #endif // !_TARTAN_CHESS_HPP_
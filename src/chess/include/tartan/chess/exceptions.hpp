@@ -20,6 +20,32 @@ public:
 	) : bad_piece(p, what_arg) {};
 };
 
+/**
+ * @brief Thrown when inserted piece exceeds
+ * the material a side can have in a game
+ *
+ * @sa tt::chess::State::hasPossibleMaterial()
+ */
+class too_many_pieces : public tt::ex::bad_piece {
+public:
+	too_many_pieces(
+		const Piece* p, 
+		const std::string& what_arg = "Side has more pieces than a game can have"
+	) : bad_piece(p, what_arg) {};
+};
+
+/**
+ * @brief Thrown when FEN string can not be loaded
+ *
+ * @sa tt::chess::Chessboard::fromFEN()
+ */
+class bad_fen : public tt::ex::tartan {
+public:
+	bad_fen(
+		const std::string& what_arg = "Invalid FEN string"
+	) : tartan(what_arg) {};
+};
+
 /**
  * @brief Thrown when tt::chess::Chessboard has 
  * no King object of certain tt::Piece::Color
@@ -0,0 +1,171 @@
+#ifndef _TARTAN_CHESS_INGEST_HPP_
+#define _TARTAN_CHESS_INGEST_HPP_
+
+#include <tartan/chess/pgn.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tt::chess {
+
+/**
+ * @brief Multi-threaded PGN import
+ *
+ * Replays and validates every game of PGN input in
+ * three stages:
+ * 1. reader thread splits the input into games with
+ *    PGNReader::next() and groups them into batches;
+ * 2. worker threads replay the batches with
+ *    PGNReader::replay(), each on its own Chessboard;
+ * 3. sink, the thread that called run(), passes the
+ *    Report of every game to the callback in input order.
+ *
+ * Stages exchange batches through the ring of queueSize()
+ * batch slots, so at most that many batches are read ahead
+ * of the sink: reader waits for the sink to free a slot,
+ * workers wait for the reader and sink waits for the worker
+ * that replays the next batch in order. Slots and their
+ * reports are reused, so once the ring has grown enough
+ * only the Chessboard replays allocate.
+ *
+ * @code
+ * MappedFile file("games.pgn");
+ * PGNIngest ingest(8);
+ * ingest.run(file.view(), [](const PGNIngest::Report& r) {
+ *     if (r.replay.status != Status::Ok)
+ *         std::cerr << "game " << r.index << ": " << what(r.replay.status) << '\n';
+ * });
+ * @endcode
+ *
+ * @sa PGNReader
+ */
+class PGNIngest {
+public:
+	/**
+	 * @brief Replayed game
+	 */
+	struct Report {
+		//! Index of the game in input, from 0
+		std::size_t index = 0;
+		//! Game, views into the run() input
+		PGNGame game;
+		//! Replay status and count of applied moves
+		PGNReplay replay;
+		//! FEN of the last position reached
+		char fen[Chessboard::fenSize] = {};
+	};
+	/**
+	 * @brief Type of the callback that receives reports
+	 */
+	using SinkT = std::function<void(const Report&)>;
+	/**
+	 * @brief Totals returned by run()
+	 */
+	struct Summary {
+		//! Count of reported games
+		std::size_t games = 0;
+		//! Count of games replayed with Status::Ok
+		std::size_t valid = 0;
+		//! Count of applied moves in every game
+		std::size_t plies = 0;
+	};
+public:
+	/**
+	 * @brief Construct new PGNIngest
+	 *
+	 * @param threads count of worker threads, 0 is treated as 1
+	 * @param batchSize count of games in batch, 0 is treated as 1
+	 * @param queueSize count of batches that are read, replayed or
+	 * wait for the sink at once, 0 is treated as twice the `threads`
+	 */
+	explicit PGNIngest(std::size_t threads = std::thread::hardware_concurrency(),
+		std::size_t batchSize = 64, std::size_t queueSize = 0);
+	PGNIngest(const PGNIngest&) = delete;
+	PGNIngest& operator=(const PGNIngest&) = delete;
+	/**
+	 * @brief Replay every game of input
+	 *
+	 * Returns when every game is reported or stop() is called.
+	 *
+	 * @param input PGN text
+	 * @param sink callback called with the Report of every
+	 * game in input order on the calling thread
+	 * @return totals of reported games
+	 */
+	Summary run(std::string_view input, const SinkT& sink);
+	/**
+	 * @brief Stop the running import
+	 *
+	 * May be called from any thread, sink included.
+	 * run() returns without reporting the games that
+	 * are not reported yet.
+	 */
+	void stop();
+	/**
+	 * @brief Count of worker threads
+	 *
+	 * @return count of threads replaying games
+	 */
+	std::size_t threads() const { return p_threads; };
+	/**
+	 * @brief Set count of worker threads
+	 *
+	 * @warning Must not be called during run()
+	 *
+	 * @param count count of threads replaying games,
+	 * 0 is treated as 1
+	 */
+	void setThreads(std::size_t count) { p_threads = count ? count : 1; };
+	/**
+	 * @brief Count of games in batch
+	 *
+	 * @return count of games reader passes to a worker at once
+	 */
+	std::size_t batchSize() const { return p_batchSize; };
+	/**
+	 * @brief Count of batch slots
+	 *
+	 * @return count of batches in flight
+	 */
+	std::size_t queueSize() const { return p_queueSize ? p_queueSize : 2*p_threads; };
+private:
+	//! Batch of games
+	struct Slot {
+		//! Reports of the batch games, reused
+		std::vector<Report> reports;
+		//! Count of games in batch
+		std::size_t count = 0;
+		//! `true` if batch is replayed
+		bool done = false;
+	};
+	//! Reader stage
+	void read(std::string_view input);
+	//! Worker stage
+	void replay();
+
+	std::size_t p_threads;
+	std::size_t p_batchSize;
+	//! Requested count of batch slots, 0 if it follows p_threads
+	std::size_t p_queueSize;
+	std::vector<Slot> p_slots;
+	//! Count of batches read
+	std::size_t p_read = 0;
+	//! Count of batches taken by workers
+	std::size_t p_taken = 0;
+	//! Count of batches reported
+	std::size_t p_reported = 0;
+	//! `true` if reader reached the end of input
+	bool p_eof = false;
+	std::atomic<bool> p_stop{false};
+	std::mutex p_mutex;
+	std::condition_variable p_reader, p_workers, p_sink;
+};
+
+}
+
+#endif // !_TARTAN_CHESS_INGEST_HPP_
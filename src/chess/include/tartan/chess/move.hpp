@@ -0,0 +1,185 @@
+#ifndef _TARTAN_CHESS_MOVE_HPP_
+#define _TARTAN_CHESS_MOVE_HPP_
+
+#include <tartan/board/bitboard.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace tt::chess {
+
+enum class PieceType : std::uint8_t;
+
+/**
+ * @brief Compact chess move
+ *
+ * Value type that packs the whole move into 16 bits:
+ * Bits  | Meaning
+ * :----:|:-------
+ * 0-5   | source tile index
+ * 6-11  | destination tile index
+ * 12-15 | Flag combination
+ *
+ * Tiles are indexed as described in tt::Bitboard.
+ * Default constructed Move is the null move, which
+ * converts to `false`.
+ *
+ * @sa MoveList, State::generate()
+ */
+class Move {
+public:
+	/**
+	 * @brief Move kind flags
+	 *
+	 * Promotion flags are combined with Capture for
+	 * promotions that capture.
+	 */
+	enum Flag : std::uint16_t {
+		Quiet = 0, //!< Move to empty tile
+		DoublePush = 1, //!< Pawn two tile move
+		KingCastle = 2, //!< Castling with the h file rook
+		QueenCastle = 3, //!< Castling with the a file rook
+		Capture = 4, //!< Capturing move
+		EnPassant = 5, //!< En passant capture
+		Promotion = 8, //!< Set for every promotion
+		KnightPromotion = 8, //!< Pawn promotion to knight
+		BishopPromotion = 9, //!< Pawn promotion to bishop
+		RookPromotion = 10, //!< Pawn promotion to rook
+		QueenPromotion = 11, //!< Pawn promotion to queen
+	};
+public:
+	//! Construct the null move
+	constexpr Move() = default;
+	/**
+	 * @brief Construct new Move
+	 *
+	 * @param from source tile index
+	 * @param to destination tile index
+	 * @param flags Flag combination
+	 */
+	constexpr Move(int from, int to, int flags = Quiet) :
+		m_move(static_cast<std::uint16_t>(from | (to << 6) | (flags << 12))) {};
+	//! Source tile index
+	constexpr int from() const { return m_move & 0x3F; };
+	//! Destination tile index
+	constexpr int to() const { return (m_move >> 6) & 0x3F; };
+	//! Flag combination
+	constexpr int flags() const { return m_move >> 12; };
+	//! `true` if move captures (en passant included)
+	constexpr bool capture() const { return flags() & Capture; };
+	//! `true` if move is a pawn promotion
+	constexpr bool promotion() const { return flags() & Promotion; };
+	//! `true` if move is a castling
+	constexpr bool castling() const {
+		return flags() == KingCastle or flags() == QueenCastle;
+	};
+	//! `true` if move is an en passant capture
+	constexpr bool enPassant() const { return flags() == EnPassant; };
+	/**
+	 * @brief Promotion piece type
+	 *
+	 * @warning Valid only if promotion() is `true`
+	 *
+	 * @return type of piece the pawn is promoted to
+	 */
+	PieceType promoteTo() const;
+	/**
+	 * @brief Raw 16-bit representation
+	 *
+	 * @return packed move value
+	 */
+	constexpr std::uint16_t raw() const { return m_move; };
+	/**
+	 * @brief String representation of the move
+	 *
+	 * Has the `<from><to>[<promotion>]` form, eq.
+	 * `e2e4`, `e1g1`, `e7e8q`.
+	 *
+	 * @return string representation of the move
+	 */
+	std::string str() const;
+	//! `false` for the null move
+	constexpr explicit operator bool() const { return m_move != 0; };
+	//! Comparison operator
+	friend constexpr bool operator==(Move lhs, Move rhs) { return lhs.m_move == rhs.m_move; };
+	//! Inverted comparison operator
+	friend constexpr bool operator!=(Move lhs, Move rhs) { return lhs.m_move != rhs.m_move; };
+private:
+	std::uint16_t m_move = 0;
+};
+
+/**
+ * @brief Fixed capacity list of Move objects
+ *
+ * Keeps up to capacity moves in place, so
+ * MoveList objects are usually allocated on the stack
+ * and filling them never touches the heap. Chessboard
+ * and FEN input reject sides with more material than
+ * a game can have (State::hasPossibleMaterial()),
+ * so the moves of a side always fit.
+ *
+ * @sa State::generate()
+ */
+class MoveList {
+public:
+	/**
+	 * @brief Maximum count of moves in the list
+	 *
+	 * Pseudo-legal moves of a side with possible material
+	 * never exceed the moves of nine queens, two rooks, 
+	 * bishops and knights on open board and a King that
+	 * can castle both ways.
+	 */
+	static constexpr std::size_t capacity = 9*27 + 2*14 + 2*13 + 2*8 + 8 + 2;
+	//! Iterator type
+	using iterator = Move*;
+	//! Constant iterator type
+	using const_iterator = const Move*;
+public:
+	//! Iterator to the first move
+	iterator begin() { return m_moves.data(); };
+	//! Iterator past the last move
+	iterator end() { return m_moves.data() + m_size; };
+	//! @copydoc begin()
+	const_iterator begin() const { return m_moves.data(); };
+	//! @copydoc end()
+	const_iterator end() const { return m_moves.data() + m_size; };
+	//! Count of moves in the list
+	std::size_t size() const { return m_size; };
+	//! `true` if list has no moves
+	bool empty() const { return m_size == 0; };
+	//! Remove every move
+	void clear() { m_size = 0; };
+	/**
+	 * @brief Append move to the list
+	 *
+	 * @warning List must not be full
+	 *
+	 * @param m appended move
+	 */
+	void push_back(Move m) { m_moves[m_size++] = m; };
+	/**
+	 * @brief Move by index
+	 *
+	 * @param i move index
+	 * @return reference to the move
+	 */
+	Move& operator[](std::size_t i) { return m_moves[i]; };
+	//! @copydoc operator[]()
+	Move operator[](std::size_t i) const { return m_moves[i]; };
+	/**
+	 * @brief Check if list contains a move
+	 *
+	 * @param m searched move
+	 * @return `true` if `m` is in the list
+	 */
+	bool contains(Move m) const;
+private:
+	std::array<Move, capacity> m_moves;
+	std::size_t m_size = 0;
+};
+
+}
+
+#endif // !_TARTAN_CHESS_MOVE_HPP_
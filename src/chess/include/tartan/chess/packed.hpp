@@ -0,0 +1,187 @@
+#ifndef _TARTAN_CHESS_PACKED_HPP_
+#define _TARTAN_CHESS_PACKED_HPP_
+
+#include <tartan/chess/state.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace tt::chess {
+
+/**
+ * @brief Byte per tile representation of chess position
+ *
+ * Value type that stores the position in a flat 64 byte
+ * array (mailbox), one byte per tile:
+ * Bits | Meaning
+ * :---:|:-------
+ * 0-2  | PieceType + 1, 0 for empty tile
+ * 3    | set for Piece::Color::White
+ *
+ * Side to move, castling rights, en passant tile and
+ * the halfmove clock with fullmove number take eight more
+ * bytes, so the whole position is 72 bytes without
+ * any heap memory. This is the form to keep a big
+ * count of games resident, where every Chessboard would
+ * hold its own Piece objects and State. Chessboard is
+ * packed with Chessboard::toPacked() and restored with
+ * Chessboard::fromPacked().
+ *
+ * PackedState makes moves itself by rewriting the tile bytes.
+ * Queries that need attacks (move generation, checks) go through
+ * state(), which rebuilds the bitboards and hash in one pass.
+ *
+ * Tiles are indexed as described in tt::Bitboard.
+ *
+ * @sa State
+ */
+class PackedState {
+public:
+	//! Construct empty position with White to move
+	PackedState() = default;
+	/**
+	 * @brief Construct new PackedState
+	 *
+	 * @param s packed position
+	 * @param halfmove halfmove clock
+	 * @param fullmove fullmove number
+	 */
+	explicit PackedState(const State& s, unsigned halfmove = 0, unsigned fullmove = 1);
+	/**
+	 * @brief Unpack the position
+	 *
+	 * @return State with the same pieces, side to move,
+	 * castling rights and en passant tile
+	 */
+	State state() const;
+	/**
+	 * @brief Check if tile is empty
+	 *
+	 * @param sq tile index
+	 * @return `true` if there is no piece at `sq`
+	 */
+	bool empty(int sq) const { return p_tiles[sq] == 0; };
+	/**
+	 * @brief Type of piece at tile
+	 *
+	 * @warning Tile `sq` must not be empty
+	 *
+	 * @param sq tile index
+	 * @return type of piece at `sq`
+	 */
+	PieceType type(int sq) const {
+		return static_cast<PieceType>((p_tiles[sq] & 7) - 1);
+	};
+	/**
+	 * @brief Color of piece at tile
+	 *
+	 * @warning Tile `sq` must not be empty
+	 *
+	 * @param sq tile index
+	 * @return color of piece at `sq`
+	 */
+	Piece::Color color(int sq) const {
+		return (p_tiles[sq] & 8) ? Piece::Color::White : Piece::Color::Black;
+	};
+	/**
+	 * @brief Raw tile byte
+	 *
+	 * @param sq tile index
+	 * @return encoded piece at `sq`, 0 for empty tile
+	 */
+	std::uint8_t at(int sq) const { return p_tiles[sq]; };
+	/**
+	 * @brief Side to move
+	 *
+	 * @return color of pieces that make the next move
+	 */
+	Piece::Color side() const { return static_cast<Piece::Color>(p_side); };
+	/**
+	 * @brief Castling rights
+	 *
+	 * @return State::Castling flags combination
+	 */
+	int castling() const { return p_castling; };
+	/**
+	 * @brief En passant tile
+	 *
+	 * @return index of the tile that pawn skipped with
+	 * the last move or -1, as State::enPassant()
+	 */
+	int enPassant() const { return p_enPassant; };
+	/**
+	 * @brief Halfmove clock
+	 *
+	 * @return count of halfmoves since the last
+	 * capture or Pawn move
+	 */
+	unsigned halfmoveClock() const { return p_halfmoveClock; };
+	/**
+	 * @brief Fullmove number
+	 *
+	 * @return number of the current full move, starts at 1
+	 * and is incremented after every Black move
+	 */
+	unsigned fullmoveNumber() const { return p_fullmoveNumber; };
+	/**
+	 * @brief Generate legal moves
+	 *
+	 * @param[out] list list to append moves to
+	 *
+	 * @sa State::generateLegal()
+	 */
+	void generateLegal(MoveList& list) const { state().generateLegal(list); };
+	/**
+	 * @brief Make move
+	 *
+	 * Same as State::makeMove(), but only the moved
+	 * tile bytes are rewritten. Clocks are advanced as
+	 * Chessboard advances them.
+	 *
+	 * @warning `m` must be a pseudo-legal move
+	 * of the current position
+	 *
+	 * @param m applied move
+	 */
+	void makeMove(Move m);
+	/**
+	 * @brief Encode piece
+	 *
+	 * @param c piece color
+	 * @param t piece type
+	 * @return tile byte of `c` colored `t` piece
+	 */
+	static constexpr std::uint8_t code(Piece::Color c, PieceType t) {
+		return static_cast<std::uint8_t>(
+			(State::index(t) + 1) | State::index(c) << 3
+		);
+	};
+	/**
+	 * @brief Comparison operator
+	 *
+	 * @return `true` if both objects have the same
+	 * pieces at the same tiles, side to move, castling
+	 * rights, en passant tile and clocks
+	 */
+	friend bool operator==(const PackedState& lhs, const PackedState& rhs);
+	/**
+	 * @brief Inverted comparison operator
+	 *
+	 * @return `!(lhs == rhs)`
+	 */
+	friend bool operator!=(const PackedState& lhs, const PackedState& rhs);
+private:
+	std::uint8_t p_tiles[64] = {};
+	std::uint8_t p_side = State::index(Piece::Color::White);
+	std::uint8_t p_castling = State::NoCastling;
+	std::int8_t p_enPassant = -1;
+	std::uint16_t p_halfmoveClock = 0;
+	std::uint16_t p_fullmoveNumber = 1;
+};
+
+static_assert(std::is_trivially_copyable<PackedState>::value, "PackedState must stay trivially copyable");
+static_assert(sizeof(PackedState) == 72, "PackedState must stay 72 bytes");
+
+}
+
+#endif // !_TARTAN_CHESS_PACKED_HPP_
@@ -0,0 +1,211 @@
+#ifndef _TARTAN_CHESS_PGN_HPP_
+#define _TARTAN_CHESS_PGN_HPP_
+
+#include <tartan/chess/chess.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tt::chess {
+
+/**
+ * @brief Read-only contents of a file
+ *
+ * On Linux the file is memory-mapped, so the contents are
+ * paged in by the system as they are read and never copied.
+ * On other systems the file is read into a buffer.
+ */
+class MappedFile {
+public:
+	/**
+	 * @brief Open file
+	 *
+	 * @param path file path
+	 * @sa isOpen()
+	 */
+	explicit MappedFile(const std::string& path);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+	/**
+	 * @brief Check if file was opened
+	 *
+	 * @return `false` if file could not be opened or read
+	 */
+	bool isOpen() const { return m_open; };
+	/**
+	 * @brief File contents
+	 *
+	 * @return view valid while MappedFile exists,
+	 * empty if file is not open
+	 */
+	std::string_view view() const { return {m_data, m_size}; };
+private:
+	//! First character of the contents
+	const char* m_data = nullptr;
+	//! Size of the contents
+	std::size_t m_size = 0;
+	//! `true` if file was opened
+	bool m_open = false;
+	//! `true` if m_data is mapped, `false` if it points into m_buffer
+	bool m_mapped = false;
+	//! Contents if file is not mapped
+	std::string m_buffer;
+};
+
+/**
+ * @brief Game of Portable Game Notation input
+ *
+ * Every string is a view into the input of PGNReader,
+ * so the game is valid while the input is.
+ */
+struct PGNGame {
+	/**
+	 * @brief Tag pair, eq. `[Event "Casual game"]`
+	 */
+	struct Tag {
+		//! Tag name
+		std::string_view name;
+		//! Tag value without the quotes, escapes are kept as is
+		std::string_view value;
+	};
+	//! Tag pairs in input order
+	std::vector<Tag> tags;
+	//! Movetext without the game termination marker
+	std::string_view movetext;
+	//! Game termination marker, empty if game has none
+	std::string_view result;
+	//! Whole game text, tag pairs included
+	std::string_view text;
+	/**
+	 * @brief Value of a tag
+	 *
+	 * @param name tag name
+	 * @return value of the first tag pair with that name,
+	 * empty if there is none
+	 */
+	std::string_view tag(std::string_view name) const;
+};
+
+/**
+ * @brief Result of PGNReader::replay()
+ */
+struct PGNReplay {
+	//! Status::Ok, FEN tag or SAN move error
+	Status status = Status::Ok;
+	//! Count of applied moves
+	std::size_t plies = 0;
+	//! Rejected move, empty if status is Status::Ok or FEN tag is invalid
+	std::string_view san;
+};
+
+/**
+ * @brief Streaming Portable Game Notation reader
+ *
+ * Splits the input into games and tokenizes their tag pairs
+ * and movetext without copying: every game, tag and
+ * move is a view into the input. The PGNGame::tags storage
+ * is reused by the next() calls, so reading a game allocates
+ * nothing once it has grown enough.
+ *
+ * Comments (`{...}` and `;` to the end of line), variations
+ * `(...)` of any depth, numeric annotation glyphs `$n`, move
+ * numbers and `%` escape lines are skipped. Game ends
+ * at the termination marker (`1-0`, `0-1`, `1/2-1/2` or `*`),
+ * or at the tag pair that starts the next game if the
+ * marker is missing.
+ *
+ * Large files are best read through MappedFile:
+ * @code
+ * MappedFile file("games.pgn");
+ * PGNReader reader(file.view());
+ * Chessboard board;
+ * reader.replayAll(board, [](const PGNGame& game, Chessboard& board, PGNReplay r) {
+ *     // inspect the final position or report r.status
+ * });
+ * @endcode
+ */
+class PGNReader {
+public:
+	/**
+	 * @brief Construct new PGNReader
+	 *
+	 * @param input PGN text, must outlive the reader
+	 * and every game it reads
+	 */
+	explicit PGNReader(std::string_view input) : p_input(input) {};
+	/**
+	 * @brief Read next game
+	 *
+	 * Tag pair that can not be parsed ends the tag section,
+	 * the rest of the game is read as movetext, so the
+	 * replay() of such game fails with Status::BadSan.
+	 *
+	 * @param[out] game read game
+	 * @return `false` if input has no more games
+	 */
+	bool next(PGNGame& game);
+	/**
+	 * @brief Offset of the unread input
+	 *
+	 * @return offset of the next game text
+	 */
+	std::size_t offset() const { return p_offset; };
+	/**
+	 * @brief Take next move from movetext
+	 *
+	 * @param[in,out] movetext movetext, the taken move and
+	 * everything before it is removed
+	 * @return SAN move token, empty at the end of movetext
+	 * or at the game termination marker
+	 */
+	static std::string_view nextSAN(std::string_view& movetext);
+	/**
+	 * @brief Replay game on Chessboard
+	 *
+	 * Chessboard is set up from the `FEN` tag if the game
+	 * has one and filled with the initial position otherwise.
+	 * Every move is resolved with Chessboard::findSAN() and
+	 * applied with Chessboard::applyMove(). Replay stops at
+	 * the first move that can not be resolved, then board
+	 * has the position before that move. Board is cleared
+	 * if the `FEN` tag is invalid.
+	 *
+	 * @param game replayed game
+	 * @param[out] board Chessboard to replay game on
+	 * @return replay status and count of applied moves
+	 */
+	static PGNReplay replay(const PGNGame& game, Chessboard& board);
+	/**
+	 * @brief Replay every remaining game
+	 *
+	 * Games are replayed one by one on the same `board` and
+	 * `f(const PGNGame&, Chessboard&, PGNReplay)` is called
+	 * after each of them.
+	 *
+	 * @param board Chessboard to replay games on
+	 * @param f callback
+	 * @return count of replayed games
+	 */
+	template<class F>
+	std::size_t replayAll(Chessboard& board, F&& f) {
+		PGNGame game;
+		std::size_t count = 0;
+		while (next(game)) {
+			PGNReplay r = replay(game, board);
+			f(static_cast<const PGNGame&>(game), board, r);
+			count++;
+		}
+		return count;
+	}
+private:
+	//! Whole input
+	std::string_view p_input;
+	//! Offset of the unread input
+	std::size_t p_offset = 0;
+};
+
+}
+
+#endif // !_TARTAN_CHESS_PGN_HPP_
@@ -0,0 +1,379 @@
+#ifndef _TARTAN_CHESS_STATE_HPP_
+#define _TARTAN_CHESS_STATE_HPP_
+
+#include <tartan/board.hpp>
+#include <tartan/board/bitboard.hpp>
+#include <tartan/chess/move.hpp>
+
+#include <type_traits>
+
+namespace tt::chess {
+
+/**
+ * @brief Chess piece kind
+ *
+ * Used to index the State bitboards.
+ */
+enum class PieceType : std::uint8_t {
+	Pawn = 0, Knight = 1, Bishop = 2,
+	Rook = 3, Queen = 4, King = 5,
+};
+
+/**
+ * @brief Bitboard representation of chess position
+ *
+ * Keeps one Bitboard for every Piece::Color and PieceType
+ * pair (12 in total), the occupancy Bitboard of each color,
+ * the side to move, castling rights and en passant tile.
+ * Chessboard keeps its State object in sync with the
+ * Piece objects on it, so the position queries could be answered
+ * with a handful of 64-bit operations instead of walking
+ * the Piece objects.
+ *
+ * State is a plain value, so it is copied to make moves
+ * with makeMove() and copied back to take them back. It is
+ * also the cheapest snapshot of a Chessboard position to 
+ * hand to another thread.
+ * Unlike Piece::moveMap() its move generation follows
+ * the standard chess rules only: pawns move two tiles from
+ * their initial rank, castling rights are lost once the King or 
+ * Rook moves.
+ *
+ * Tiles are indexed as described in tt::Bitboard.
+ *
+ * @sa Chessboard::state()
+ */
+class State {
+public:
+	/**
+	 * @brief Castling rights flags
+	 *
+	 * @sa castling()
+	 */
+	enum Castling : int {
+		WhiteKingside = 1, //!< White King may castle with h1 Rook
+		WhiteQueenside = 2, //!< White King may castle with a1 Rook
+		BlackKingside = 4, //!< Black King may castle with h8 Rook
+		BlackQueenside = 8, //!< Black King may castle with a8 Rook
+		NoCastling = 0, //!< No castling rights
+		AnyCastling = 15, //!< Every castling right
+	};
+	/**
+	 * @brief King safety masks of a position
+	 *
+	 * Computed once per position with checkInfo() and
+	 * used by isLegal() to validate every move of 
+	 * the side without applying it.
+	 */
+	struct CheckInfo {
+		//! King tile index
+		int king;
+		//! Enemy pieces that attack the King
+		Bitboard checkers;
+		//! Own pieces that shield the King from enemy sliding pieces
+		Bitboard pinned;
+		/**
+		 * @brief Check evasion tiles
+		 *
+		 * Tiles at which a non-king move has to end up 
+		 * when the King is in check from a single piece:
+		 * the checker tile and the tiles between the checker 
+		 * and the King. Every tile if there is no check.
+		 */
+		Bitboard evasions;
+	};
+public:
+	/**
+	 * @brief Pieces of some color and type
+	 *
+	 * @param c Piece color
+	 * @param t Piece type
+	 * @return Bitboard of tiles with `c` colored `t` pieces
+	 */
+	Bitboard pieces(Piece::Color c, PieceType t) const {
+		return s_pieces[index(c)][index(t)];
+	};
+	/**
+	 * @brief Pieces of some type of both colors
+	 *
+	 * @param t Piece type
+	 * @return Bitboard of tiles with `t` pieces
+	 */
+	Bitboard pieces(PieceType t) const {
+		return s_pieces[0][index(t)] | s_pieces[1][index(t)];
+	};
+	/**
+	 * @brief Tiles occupied by some color
+	 *
+	 * @param c Piece color
+	 * @return Bitboard of tiles with pieces of `c` color
+	 */
+	Bitboard occupancy(Piece::Color c) const {
+		return s_occupancy[index(c)];
+	};
+	/**
+	 * @brief Tiles occupied by any piece
+	 *
+	 * @return Bitboard of non-empty tiles
+	 */
+	Bitboard occupancy() const {
+		return s_occupancy[0] | s_occupancy[1];
+	};
+	/**
+	 * @brief Type of piece at tile
+	 *
+	 * @warning Tile `sq` must not be empty
+	 *
+	 * @param sq tile index
+	 * @return type of piece at `sq`
+	 */
+	PieceType type(int sq) const;
+	/**
+	 * @brief Color of piece at tile
+	 *
+	 * @warning Tile `sq` must not be empty
+	 *
+	 * @param sq tile index
+	 * @return color of piece at `sq`
+	 */
+	Piece::Color color(int sq) const {
+		return (s_occupancy[1] & bit(sq)) ?
+			Piece::Color::White : Piece::Color::Black;
+	};
+	/**
+	 * @brief Put piece on the tile
+	 *
+	 * @warning Tile `sq` must be empty
+	 *
+	 * @param sq tile index
+	 * @param c piece color
+	 * @param t piece type
+	 */
+	void put(int sq, Piece::Color c, PieceType t);
+	/**
+	 * @brief Remove piece from the tile
+	 *
+	 * @warning Tile `sq` must not be empty
+	 *
+	 * @param sq tile index
+	 */
+	void remove(int sq);
+	/**
+	 * @brief Move piece between tiles
+	 *
+	 * @warning Tile `from` must not be empty,
+	 * tile `to` must be empty
+	 *
+	 * @param from source tile index
+	 * @param to destination tile index
+	 */
+	void move(int from, int to);
+	//! Remove every piece and reset the game properties
+	void clear();
+	/**
+	 * @brief Side to move
+	 *
+	 * @return color of pieces that make the next move
+	 */
+	Piece::Color side() const { return s_side; };
+	/**
+	 * @brief Set side to move
+	 *
+	 * @param c color of pieces that make the next move
+	 */
+	void setSide(Piece::Color c);
+	/**
+	 * @brief Castling rights
+	 *
+	 * @return Castling flags combination
+	 */
+	int castling() const { return s_castling; };
+	/**
+	 * @brief Set castling rights
+	 *
+	 * @param c Castling flags combination
+	 */
+	void setCastling(int c);
+	/**
+	 * @brief En passant tile
+	 *
+	 * @return index of the tile that pawn skipped with
+	 * the last move or -1 if last move was not 
+	 * a double pawn push or no pawn can capture
+	 * en passant
+	 */
+	int enPassant() const { return s_enPassant; };
+	/**
+	 * @brief Set en passant tile
+	 *
+	 * Tile is set only if a pawn attacks it, -1 is set 
+	 * otherwise. So the positions that differ only by an 
+	 * en passant tile no pawn can capture onto have
+	 * equal hash() and FEN.
+	 *
+	 * @warning Pieces have to be placed before the tile is set
+	 *
+	 * @param sq tile index or -1
+	 */
+	void setEnPassant(int sq);
+	/**
+	 * @brief Zobrist hash of the position
+	 *
+	 * 64-bit key that covers the piece placement, side 
+	 * to move, castling rights and en passant tile file. It is
+	 * updated incrementally by every modifying method, so
+	 * equal positions have equal keys regardless of the way 
+	 * they were reached. Empty State with White to move
+	 * has the key 0.
+	 *
+	 * @return position key
+	 */
+	std::uint64_t hash() const { return s_hash; };
+	/**
+	 * @brief Pieces that attack a tile
+	 *
+	 * Works backwards from the tile: the attacks of 
+	 * every piece type are cast from `sq` and
+	 * intersected with the pieces of that type.
+	 *
+	 * @param sq attacked tile index
+	 * @param occupancy occupied tiles, that block 
+	 * sliding pieces
+	 * @return Bitboard of pieces of both colors that attack `sq`
+	 */
+	Bitboard attackersOf(int sq, Bitboard occupancy) const;
+	/**
+	 * @brief Pieces that attack a tile
+	 *
+	 * @param sq attacked tile index
+	 * @return Bitboard of pieces of both colors that attack `sq`
+	 */
+	Bitboard attackersOf(int sq) const { return attackersOf(sq, occupancy()); };
+	/**
+	 * @brief Check if a tile is attacked
+	 *
+	 * @param sq tile index
+	 * @param by attacking pieces color
+	 * @return `true` if any piece of `by` color attacks `sq`
+	 */
+	bool isSquareAttacked(int sq, Piece::Color by) const;
+	/**
+	 * @brief Check if a side has material a game can have
+	 *
+	 * Every piece above the initial set is promoted from
+	 * a missing pawn, so a side has at most 16 pieces,
+	 * at most 8 pawns, and at most 8 promoted pieces
+	 * together with the pawns.
+	 *
+	 * @param c side color
+	 * @return `true` if material of `c` is possible
+	 * @sa MoveList::capacity
+	 */
+	bool hasPossibleMaterial(Piece::Color c) const;
+	/**
+	 * @brief Generate pseudo-legal moves
+	 *
+	 * Appends every move of the side() pieces to `list`,
+	 * including the moves that leave own King in check.
+	 * Castling is generated when rights allow it and tiles 
+	 * between the King and Rook are empty, attacked tiles 
+	 * are not considered.
+	 * Function does not allocate memory.
+	 *
+	 * @param[out] list list to append moves to
+	 */
+	void generate(MoveList& list) const { generate(list, s_side); };
+	/**
+	 * @brief Generate pseudo-legal moves of some color
+	 *
+	 * @copydetails generate(MoveList&) const
+	 * @param c color of moving pieces
+	 */
+	void generate(MoveList& list, Piece::Color c) const;
+	/**
+	 * @brief Generate legal moves
+	 *
+	 * Appends every legal move of the side() pieces to `list`.
+	 * Pinned pieces and check evasion tiles are computed once
+	 * with checkInfo(), so moves are never applied to
+	 * validate them.
+	 * Function does not allocate memory.
+	 *
+	 * @param[out] list list to append moves to
+	 */
+	void generateLegal(MoveList& list) const { generateLegal(list, s_side); };
+	/**
+	 * @brief Generate legal moves of some color
+	 *
+	 * @copydetails generateLegal(MoveList&) const
+	 * @warning King of `c` color has to be present
+	 * @param c color of moving pieces
+	 */
+	void generateLegal(MoveList& list, Piece::Color c) const;
+	/**
+	 * @brief King safety masks of the position
+	 *
+	 * @warning King of `c` color has to be present
+	 *
+	 * @param c King color
+	 * @return CheckInfo of the `c` colored King
+	 */
+	CheckInfo checkInfo(Piece::Color c) const;
+	/**
+	 * @brief Check if pseudo-legal move is legal
+	 *
+	 * Move is legal if the King of moving piece color is 
+	 * not attacked after the move. Castling is also illegal
+	 * if the King is in check or passes through
+	 * the attacked tile.
+	 *
+	 * @param m pseudo-legal move
+	 * @param ci checkInfo() of the moving piece color
+	 * @return `true` if `m` is legal
+	 */
+	bool isLegal(Move m, const CheckInfo& ci) const;
+	/**
+	 * @brief Make move
+	 *
+	 * Updates pieces, castling rights, en passant tile 
+	 * and passes the move to the other side.
+	 *
+	 * @warning `m` must be a pseudo-legal move 
+	 * of the current position
+	 *
+	 * @param m applied move
+	 */
+	void makeMove(Move m);
+	/**
+	 * @brief Comparison operator
+	 *
+	 * @return `true` if both objects have the same
+	 * pieces at the same tiles, side to move, castling
+	 * rights and en passant tile
+	 */
+	friend bool operator==(const State& lhs, const State& rhs);
+	/**
+	 * @brief Inverted comparison operator
+	 *
+	 * @return `!(lhs == rhs)`
+	 */
+	friend bool operator!=(const State& lhs, const State& rhs);
+public:
+	//! Bitboard array index of Piece::Color
+	static constexpr int index(Piece::Color c) { return static_cast<int>(c); };
+	//! Bitboard array index of PieceType
+	static constexpr int index(PieceType t) { return static_cast<int>(t); };
+private:
+	Bitboard s_pieces[2][6] = {};
+	Bitboard s_occupancy[2] = {};
+	Piece::Color s_side = Piece::Color::White;
+	std::uint8_t s_castling = NoCastling;
+	std::int8_t s_enPassant = -1;
+	std::uint64_t s_hash = 0;
+};
+
+static_assert(std::is_trivially_copyable<State>::value, "State must stay trivially copyable");
+
+}
+
+#endif // !_TARTAN_CHESS_STATE_HPP_
@@ -0,0 +1,147 @@
+#ifndef _TARTAN_CHESS_TRANSPOSITION_HPP_
+#define _TARTAN_CHESS_TRANSPOSITION_HPP_
+
+#include <tartan/chess/move.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace tt::chess {
+
+/**
+ * @brief Shared position analysis cache
+ *
+ * Fixed size hash table keyed by State::hash(). Every
+ * slot keeps the depth, bound type, score and best move
+ * of one position packed into 16 bytes.
+ *
+ * Any count of threads may probe() and store()
+ * concurrently without locks. Slot stores the key XOR-ed
+ * with the data next to the data itself, so the slot torn
+ * by a concurrent store() fails the key verification and
+ * is reported as a miss instead of returning data of
+ * another position.
+ *
+ * Table memory is allocated in huge pages when the system
+ * allows it and in normal pages otherwise.
+ */
+class TranspositionTable {
+public:
+	/**
+	 * @brief Score bound kind
+	 */
+	enum Bound : std::uint8_t {
+		NoBound = 0, //!< Slot is empty
+		UpperBound = 1, //!< Score is at most Entry::score
+		LowerBound = 2, //!< Score is at least Entry::score
+		ExactBound = 3, //!< Score is exact
+	};
+	/**
+	 * @brief Position analysis data
+	 */
+	struct Entry {
+		//! Best move, may be the null Move
+		Move move;
+		//! Position score
+		std::int16_t score = 0;
+		//! Analysis depth
+		std::int8_t depth = 0;
+		//! Kind of score
+		Bound bound = NoBound;
+	};
+public:
+	/**
+	 * @brief Construct new TranspositionTable
+	 *
+	 * @param size table size in MiB, rounded down to
+	 * the power of two count of entries
+	 */
+	explicit TranspositionTable(std::size_t size = 16);
+	TranspositionTable(const TranspositionTable&) = delete;
+	TranspositionTable& operator=(const TranspositionTable&) = delete;
+	~TranspositionTable();
+	/**
+	 * @brief Reallocate the table
+	 *
+	 * Every entry is lost.
+	 *
+	 * @warning Must not be called while other threads
+	 * use the table
+	 *
+	 * @param size table size in MiB
+	 */
+	void resize(std::size_t size);
+	/**
+	 * @brief Remove every entry
+	 *
+	 * @copydetails resize()
+	 */
+	void clear();
+	/**
+	 * @brief Start new search
+	 *
+	 * Entries stored before the call are replaced
+	 * first by store().
+	 */
+	void newSearch() { t_generation = (t_generation + 1) & 63; };
+	/**
+	 * @brief Look up position
+	 *
+	 * @param key position hash
+	 * @param[out] e position data, if found
+	 * @return `true` if the position is found
+	 */
+	bool probe(std::uint64_t key, Entry& e) const;
+	/**
+	 * @brief Save position data
+	 *
+	 * Entry of another position in the slot is replaced
+	 * if it was stored by previous search or with
+	 * not much bigger depth. Best move of the same
+	 * position is kept if `e` has none.
+	 *
+	 * @param key position hash
+	 * @param e position data
+	 */
+	void store(std::uint64_t key, const Entry& e);
+	/**
+	 * @brief Count of table slots
+	 *
+	 * @return count of entries table can store
+	 */
+	std::size_t size() const { return t_mask + 1; };
+	/**
+	 * @brief Table fill rate
+	 *
+	 * Estimated with the first thousand slots.
+	 *
+	 * @return permille of slots used by current search
+	 */
+	int hashfull() const;
+	/**
+	 * @brief Huge pages usage
+	 *
+	 * @return `true` if system accepted the huge pages
+	 * request for the table memory
+	 */
+	bool hugePages() const { return t_huge; };
+private:
+	struct Slot {
+		std::atomic<std::uint64_t> key;
+		std::atomic<std::uint64_t> data;
+	};
+	static_assert(sizeof(Slot) == 16, "TranspositionTable slot must be 16 bytes");
+
+	void allocate(std::size_t bytes);
+	void release();
+
+	Slot* t_slots = nullptr;
+	std::size_t t_mask = 0;
+	std::size_t t_bytes = 0;
+	bool t_huge = false;
+	std::uint8_t t_generation = 0;
+};
+
+}
+
+#endif // !_TARTAN_CHESS_TRANSPOSITION_HPP_
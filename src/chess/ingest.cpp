@@ -0,0 +1,130 @@
+#include <tartan/chess/ingest.hpp>
+
+namespace tt::chess {
+
+PGNIngest::PGNIngest(std::size_t threads, std::size_t batchSize, std::size_t queueSize) :
+	p_threads(threads ? threads : 1),
+	p_batchSize(batchSize ? batchSize : 1),
+	p_queueSize(queueSize) {}
+
+PGNIngest::Summary PGNIngest::run(std::string_view input, const SinkT& sink) {
+	p_slots.resize(queueSize());
+	for (Slot& s : p_slots) {
+		s.reports.resize(p_batchSize);
+		s.count = 0;
+		s.done = false;
+	}
+	p_read = p_taken = p_reported = 0;
+	p_eof = false;
+	p_stop = false;
+
+	std::thread reader(&PGNIngest::read, this, input);
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < p_threads; i++)
+		workers.emplace_back(&PGNIngest::replay, this);
+
+	// stages are joined even if the sink throws
+	struct Join {
+		PGNIngest& ingest;
+		std::thread& reader;
+		std::vector<std::thread>& workers;
+		~Join() {
+			ingest.stop();
+			reader.join();
+			for (std::thread& w : workers)
+				w.join();
+		}
+	} join{*this, reader, workers};
+
+	Summary summary;
+	std::unique_lock lock(p_mutex);
+	while (true) {
+		Slot& slot = p_slots[p_reported % p_slots.size()];
+		p_sink.wait(lock, [&]() {
+			return p_stop or slot.done or (p_eof and p_reported == p_read);
+		});
+		if (p_stop or !slot.done)
+			break;
+		lock.unlock();
+
+		for (std::size_t i = 0; i < slot.count and !p_stop; i++) {
+			const Report& r = slot.reports[i];
+			summary.games++;
+			summary.valid += r.replay.status == Status::Ok;
+			summary.plies += r.replay.plies;
+			sink(r);
+		}
+
+		lock.lock();
+		slot.done = false;
+		p_reported++;
+		p_reader.notify_one();
+	}
+	return summary;
+}
+
+void PGNIngest::stop() {
+	{
+		std::lock_guard lock(p_mutex);
+		p_stop = true;
+	}
+	p_reader.notify_all();
+	p_workers.notify_all();
+	p_sink.notify_all();
+}
+
+void PGNIngest::read(std::string_view input) {
+	PGNReader reader(input);
+	std::size_t index = 0;
+	bool more = true;
+	std::unique_lock lock(p_mutex);
+	while (more) {
+		p_reader.wait(lock, [this]() {
+			return p_stop or p_read < p_reported + p_slots.size();
+		});
+		if (p_stop)
+			return;
+		// slot is free, no other stage touches it
+		Slot& slot = p_slots[p_read % p_slots.size()];
+		lock.unlock();
+
+		slot.count = 0;
+		while (slot.count < p_batchSize and (more = reader.next(slot.reports[slot.count].game)))
+			slot.reports[slot.count++].index = index++;
+
+		lock.lock();
+		if (slot.count) {
+			p_read++;
+			p_workers.notify_one();
+		}
+	}
+	p_eof = true;
+	p_workers.notify_all();
+	p_sink.notify_all();
+}
+
+void PGNIngest::replay() {
+	Chessboard board;
+	std::unique_lock lock(p_mutex);
+	while (true) {
+		p_workers.wait(lock, [this]() {
+			return p_stop or p_eof or p_taken < p_read;
+		});
+		if (p_stop or p_taken == p_read)
+			return;
+		Slot& slot = p_slots[p_taken++ % p_slots.size()];
+		lock.unlock();
+
+		for (std::size_t i = 0; i < slot.count and !p_stop; i++) {
+			Report& r = slot.reports[i];
+			r.replay = PGNReader::replay(r.game, board);
+			board.toFEN(r.fen);
+		}
+
+		lock.lock();
+		slot.done = true;
+		p_sink.notify_one();
+	}
+}
+
+}
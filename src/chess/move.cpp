@@ -0,0 +1,30 @@
+#include <tartan/chess/move.hpp>
+#include <tartan/chess/state.hpp>
+
+#include <algorithm>
+
+namespace tt::chess {
+
+PieceType Move::promoteTo() const {
+	return static_cast<PieceType>(
+		static_cast<int>(PieceType::Knight) + (flags() & 3)
+	);
+}
+
+std::string Move::str() const {
+	std::string s = {
+		static_cast<char>('a' + squareX(from()) - 1),
+		static_cast<char>('0' + squareY(from())),
+		static_cast<char>('a' + squareX(to()) - 1),
+		static_cast<char>('0' + squareY(to())),
+	};
+	if (promotion())
+		s.push_back("nbrq"[flags() & 3]);
+	return s;
+}
+
+bool MoveList::contains(Move m) const {
+	return std::find(begin(), end(), m) != end();
+}
+
+}
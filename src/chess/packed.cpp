@@ -0,0 +1,107 @@
+#include <tartan/chess.hpp>
+#include <tartan/board/attacks.hpp>
+
+#include <algorithm>
+
+namespace tt::chess {
+
+namespace {
+
+// castling rights kept after a move touches the tile
+int castlingKept(int sq) {
+	switch (sq) {
+		case square(1, 1): return ~State::WhiteQueenside;
+		case square(5, 1): return ~(State::WhiteKingside | State::WhiteQueenside);
+		case square(8, 1): return ~State::WhiteKingside;
+		case square(1, 8): return ~State::BlackQueenside;
+		case square(5, 8): return ~(State::BlackKingside | State::BlackQueenside);
+		case square(8, 8): return ~State::BlackKingside;
+		default: return State::AnyCastling;
+	}
+}
+
+}
+
+PackedState::PackedState(const State& s, unsigned halfmove, unsigned fullmove) :
+	p_side(State::index(s.side())),
+	p_castling(static_cast<std::uint8_t>(s.castling())),
+	p_enPassant(static_cast<std::int8_t>(s.enPassant())),
+	p_halfmoveClock(static_cast<std::uint16_t>(halfmove)),
+	p_fullmoveNumber(static_cast<std::uint16_t>(fullmove)) {
+	Bitboard occupied = s.occupancy();
+	while (occupied) {
+		int sq = popLsb(occupied);
+		p_tiles[sq] = code(s.color(sq), s.type(sq));
+	}
+}
+
+State PackedState::state() const {
+	State s;
+	for (int sq = 0; sq < 64; sq++)
+		if (p_tiles[sq])
+			s.put(sq, color(sq), type(sq));
+	s.setSide(side());
+	s.setCastling(p_castling);
+	s.setEnPassant(p_enPassant);
+	return s;
+}
+
+void PackedState::makeMove(Move m) {
+	int from = m.from(), to = m.to();
+	bool white = side() == Piece::Color::White;
+	bool pawn = type(from) == PieceType::Pawn;
+
+	switch (m.flags()) {
+		case Move::EnPassant:
+			p_tiles[white ? to - 8 : to + 8] = 0;
+			break;
+		case Move::KingCastle:
+			p_tiles[to - 1] = p_tiles[to + 1];
+			p_tiles[to + 1] = 0;
+			break;
+		case Move::QueenCastle:
+			p_tiles[to + 1] = p_tiles[to - 2];
+			p_tiles[to - 2] = 0;
+			break;
+	}
+
+	p_tiles[to] = m.promotion() ? code(side(), m.promoteTo()) : p_tiles[from];
+	p_tiles[from] = 0;
+
+	p_castling &= castlingKept(from) & castlingKept(to);
+	// set only if an enemy pawn can capture, as State::setEnPassant() does
+	p_enPassant = -1;
+	if (m.flags() == Move::DoublePush) {
+		Piece::Color enemy = white ? Piece::Color::Black : Piece::Color::White;
+		Bitboard capturers = pawnAttacks(side(), (from + to)/2);
+		while (capturers)
+			if (p_tiles[popLsb(capturers)] == code(enemy, PieceType::Pawn))
+				p_enPassant = static_cast<std::int8_t>((from + to)/2);
+	}
+	p_side = !white;
+	p_halfmoveClock = pawn or m.capture() ? 0 : p_halfmoveClock + 1;
+	p_fullmoveNumber += !white;
+}
+
+bool operator==(const PackedState& lhs, const PackedState& rhs) {
+	return std::equal(lhs.p_tiles, lhs.p_tiles + 64, rhs.p_tiles) and
+		lhs.p_side == rhs.p_side and
+		lhs.p_castling == rhs.p_castling and
+		lhs.p_enPassant == rhs.p_enPassant and
+		lhs.p_halfmoveClock == rhs.p_halfmoveClock and
+		lhs.p_fullmoveNumber == rhs.p_fullmoveNumber;
+}
+
+bool operator!=(const PackedState& lhs, const PackedState& rhs) {
+	return !(lhs == rhs);
+}
+
+void Chessboard::fromPacked(const PackedState& p) {
+	load(p.state(), p.halfmoveClock(), p.fullmoveNumber());
+}
+
+PackedState Chessboard::toPacked() const {
+	return PackedState(c_state, c_halfmoveClock, static_cast<unsigned>(fullmoveNumber()));
+}
+
+}
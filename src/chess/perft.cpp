@@ -0,0 +1,158 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/exceptions.hpp>
+
+#include <vector>
+
+namespace tt::chess {
+using TurnMap = Piece::TurnMap;
+using Turn = Piece::Turn;
+using Color = Piece::Color;
+
+namespace {
+
+std::uint64_t mix(std::uint64_t h, std::uint64_t v) {
+	h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+	h ^= h >> 31;
+	h *= 0xBF58476D1CE4E5B9ULL;
+	return h ^ (h >> 29);
+}
+
+// Move::str() form of the turn
+std::string name(const Turn* t) {
+	int flags = Move::Quiet;
+	PieceType type;
+	if (t->piece()->type() == State::index(PieceType::Pawn) and
+		promotionType(static_cast<const Pawn::Turn*>(t)->promoteTo(), type))
+		flags = Move::Promotion | (State::index(type) - 1);
+	return Move(t->from().square().index(), t->to().square().index(), flags).str();
+}
+
+}
+
+class Chessboard::PerftTable {
+public:
+	PerftTable(std::size_t size) {
+		std::size_t count = 1;
+		while (count * 2 * sizeof(Entry) <= size)
+			count *= 2;
+		t_entries.resize(count);
+		t_mask = count - 1;
+	}
+
+	bool probe(std::uint64_t key, int depth, std::uint64_t& nodes) const {
+		const Entry& e = t_entries[key & t_mask];
+		if (e.key != key or e.depth != depth)
+			return false;
+		nodes = e.nodes;
+		return true;
+	}
+
+	void store(std::uint64_t key, int depth, std::uint64_t nodes) {
+		t_entries[key & t_mask] = {key, nodes, depth};
+	}
+private:
+	struct Entry {
+		std::uint64_t key = 0;
+		std::uint64_t nodes = 0;
+		int depth = 0;
+	};
+	std::vector<Entry> t_entries;
+	std::size_t t_mask;
+};
+
+std::uint64_t Chessboard::perft(int depth, std::size_t hashSize) {
+	if (depth <= 0)
+		return 1;
+
+	if (!hashSize)
+		return perft(depth, nullptr, nullptr);
+
+	PerftTable table(hashSize << 20);
+	return perft(depth, &table, nullptr);
+}
+
+Chessboard::PerftDivideT Chessboard::perftDivide(int depth, std::size_t hashSize) {
+	PerftDivideT divide;
+	if (depth <= 0)
+		return divide;
+
+	if (!hashSize) {
+		perft(depth, nullptr, &divide);
+	} else {
+		PerftTable table(hashSize << 20);
+		perft(depth, &table, &divide);
+	}
+
+	return divide;
+}
+
+std::uint64_t Chessboard::perft(int depth, PerftTable* table, PerftDivideT* divide) {
+	if (!c_currentKing)
+		TARTAN_THROW(ex::no_king(b_currentTurnColor));
+
+	std::uint64_t key = 0, nodes = 0;
+	if (table and !divide) {
+		key = perftKey();
+		if (table->probe(key, depth, nodes))
+			return nodes;
+	}
+
+	// all the moveMap()s have to be produced before any
+	// Turn::apply(), because en passant turns are valid
+	// only until the next one. King goes last for 
+	// the same reason: castling validation applies turns too.
+	TurnMap map;
+	for (int t = 0; t < 6; t++) {
+		Bitboard pieces = c_state.pieces(b_currentTurnColor, PieceType(t));
+		while (pieces) {
+			int sq = popLsb(pieces);
+			map.splice(map.end(), at({squareX(sq), squareY(sq)})->moveMap());
+		}
+	}
+	markChecks(map);
+
+	Color side = b_currentTurnColor;
+	Color enemy = side == Color::White ? Color::Black : Color::White;
+	for (auto& t : map) {
+		if (!t->possible())
+			continue;
+
+		std::uint64_t count = 1;
+		if (depth > 1) {
+			t->apply(CheckingMode);
+			setCurrentTurn(enemy);
+			count = perft(depth - 1, table, nullptr);
+			setCurrentTurn(side);
+			t->undo();
+		}
+
+		if (divide)
+			divide->push_back({name(t), count});
+		nodes += count;
+	}
+
+	if (table and !divide)
+		table->store(key, depth, nodes);
+
+	return nodes;
+}
+
+std::uint64_t Chessboard::perftKey() const {
+	Color enemy = b_currentTurnColor == Color::White ? Color::Black : Color::White;
+	Bitboard unmoved = 0, passant = 0;
+	for (const auto& list : b_pieces) {
+		for (const Piece* p : list) {
+			int sq = p->position().square().index();
+			if (p->movesMade() == 0)
+				unmoved |= bit(sq);
+			else if (p->movesMade() == 1 and p->color() == enemy and
+				p->turnIndex() == b_turnIndex and
+				p->type() == State::index(PieceType::Pawn))
+				passant |= bit(sq);
+		}
+	}
+
+	return mix(mix(hash(), unmoved), passant);
+}
+
+}
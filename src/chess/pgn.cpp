@@ -0,0 +1,383 @@
+#include <tartan/chess/pgn.hpp>
+
+#include <cstdio>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tt::chess {
+
+namespace {
+
+bool space(char c) {
+	return c == ' ' or c == '\t' or c == '\n' or c == '\r' or c == '\f' or c == '\v';
+}
+
+bool digit(char c) {
+	return c >= '0' and c <= '9';
+}
+
+bool delimiter(char c) {
+	return space(c) or c == '{' or c == '}' or c == '(' or c == ')' or c == ';';
+}
+
+bool result(std::string_view t) {
+	return t == "1-0" or t == "0-1" or t == "1/2-1/2" or t == "*";
+}
+
+// `s` is a view into the input that starts at `begin`
+bool lineStart(std::string_view s, const char* begin) {
+	return s.data() == begin or s.data()[-1] == '\n';
+}
+
+void skipLine(std::string_view& s) {
+	std::size_t eol = s.find('\n');
+	s.remove_prefix(eol == std::string_view::npos ? s.size() : eol + 1);
+}
+
+// s[0] is `{` or `;`
+void skipComment(std::string_view& s) {
+	if (s[0] == ';')
+		return skipLine(s);
+	std::size_t end = s.find('}');
+	s.remove_prefix(end == std::string_view::npos ? s.size() : end + 1);
+}
+
+// s[0] is `(`
+void skipVariation(std::string_view& s) {
+	int depth = 0;
+	while (!s.empty()) {
+		char c = s[0];
+		if (c == '{' or c == ';') {
+			skipComment(s);
+			continue;
+		}
+		s.remove_prefix(1);
+		if (c == '(')
+			depth++;
+		else if (c == ')' and --depth == 0)
+			return;
+	}
+}
+
+// removes whitespace and escape lines
+void skipBlank(std::string_view& s, const char* begin) {
+	while (!s.empty()) {
+		if (space(s[0]))
+			s.remove_prefix(1);
+		else if (s[0] == '%' and lineStart(s, begin))
+			skipLine(s);
+		else
+			return;
+	}
+}
+
+// next token, comments, variations and NAGs are skipped
+std::string_view token(std::string_view& s, const char* begin) {
+	while (!s.empty()) {
+		char c = s[0];
+		if (space(c)) {
+			s.remove_prefix(1);
+		} else if (c == '%' and lineStart(s, begin)) {
+			skipLine(s);
+		} else if (c == '{' or c == ';') {
+			skipComment(s);
+		} else if (c == '(') {
+			skipVariation(s);
+		} else if (c == ')' or c == '}') {
+			s.remove_prefix(1);
+		} else if (c == '$') {
+			s.remove_prefix(1);
+			while (!s.empty() and digit(s[0]))
+				s.remove_prefix(1);
+		} else {
+			break;
+		}
+	}
+
+	std::size_t n = 0;
+	while (n < s.size() and !delimiter(s[n]))
+		n++;
+	std::string_view t = s.substr(0, n);
+	s.remove_prefix(n);
+	return t;
+}
+
+std::string_view trimmed(const char* from, const char* to) {
+	while (to > from and space(to[-1]))
+		to--;
+	return {from, static_cast<std::size_t>(to - from)};
+}
+
+// s[0] is `[`, tag pair is removed from `s` if it is valid
+bool tag(std::string_view& s, std::vector<PGNGame::Tag>& tags) {
+	std::size_t i = 1, size = s.size();
+	auto blank = [&]() {
+		while (i < size and s[i] != '\n' and space(s[i]))
+			i++;
+	};
+
+	blank();
+	std::size_t name = i;
+	while (i < size and (digit(s[i]) or s[i] == '_' or
+		(s[i] >= 'a' and s[i] <= 'z') or (s[i] >= 'A' and s[i] <= 'Z')))
+		i++;
+	if (i == name)
+		return false;
+	std::string_view n = s.substr(name, i - name);
+
+	blank();
+	if (i == size or s[i] != '"')
+		return false;
+	std::size_t value = ++i;
+	while (i < size and s[i] != '"' and s[i] != '\n') {
+		if (s[i] == '\\' and i + 1 < size)
+			i++;
+		i++;
+	}
+	if (i == size or s[i] != '"')
+		return false;
+	std::string_view v = s.substr(value, i++ - value);
+
+	blank();
+	if (i == size or s[i] != ']')
+		return false;
+	tags.push_back({n, v});
+	s.remove_prefix(i + 1);
+	return true;
+}
+
+bool pieceLetter(char c, PieceType& t) {
+	switch (c) {
+		case 'N': t = PieceType::Knight; return true;
+		case 'B': t = PieceType::Bishop; return true;
+		case 'R': t = PieceType::Rook; return true;
+		case 'Q': t = PieceType::Queen; return true;
+		case 'K': t = PieceType::King; return true;
+		default: return false;
+	}
+}
+
+}
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(__linux__)
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+	struct stat st;
+	if (fstat(fd, &st) == 0) {
+		m_size = static_cast<std::size_t>(st.st_size);
+		m_open = true;
+		if (m_size) {
+			void* p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p != MAP_FAILED) {
+				madvise(p, m_size, MADV_SEQUENTIAL);
+				m_data = static_cast<const char*>(p);
+				m_mapped = true;
+			} else {
+				m_size = 0;
+				m_open = false;
+			}
+		}
+	}
+	::close(fd);
+#else
+	std::FILE* f = std::fopen(path.c_str(), "rb");
+	if (!f)
+		return;
+	char chunk[1 << 16];
+	std::size_t n;
+	while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0)
+		m_buffer.append(chunk, n);
+	m_open = !std::ferror(f);
+	std::fclose(f);
+	m_data = m_buffer.data();
+	m_size = m_open ? m_buffer.size() : 0;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if defined(__linux__)
+	if (m_mapped)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+std::string_view PGNGame::tag(std::string_view name) const {
+	for (const Tag& t : tags)
+		if (t.name == name)
+			return t.value;
+	return {};
+}
+
+bool PGNReader::next(PGNGame& game) {
+	const char* begin = p_input.data();
+	std::string_view s = p_input.substr(p_offset);
+	skipBlank(s, begin);
+	if (s.empty()) {
+		p_offset = p_input.size();
+		return false;
+	}
+
+	const char* start = s.data();
+	game.tags.clear();
+	game.result = {};
+	while (!s.empty() and s[0] == '[' and tag(s, game.tags))
+		skipBlank(s, begin);
+
+	const char* movetext = s.data();
+	const char* end = s.data() + s.size();
+	for (;;) {
+		std::string_view t = token(s, begin);
+		if (t.empty()) {
+			end = s.data();
+			break;
+		}
+		if (result(t)) {
+			game.result = t;
+			end = t.data();
+			break;
+		}
+		// tag pair of the next game, this one has no termination marker
+		if (t[0] == '[' and t.data() != movetext and lineStart(t, begin)) {
+			end = t.data();
+			s = p_input.substr(static_cast<std::size_t>(end - begin));
+			break;
+		}
+	}
+
+	game.movetext = trimmed(movetext, end);
+	game.text = trimmed(start, s.data());
+	p_offset = static_cast<std::size_t>(s.data() - begin);
+	return true;
+}
+
+std::string_view PGNReader::nextSAN(std::string_view& movetext) {
+	for (;;) {
+		std::string_view t = token(movetext, movetext.data());
+		if (t.empty() or result(t)) {
+			movetext.remove_prefix(movetext.size());
+			return {};
+		}
+		// move number, eq. `12.`, `12...` or `12.Nf3`, but not `0-0`
+		if ((digit(t[0]) and t.substr(0, 3) != "0-0") or t[0] == '.') {
+			while (!t.empty() and digit(t[0]))
+				t.remove_prefix(1);
+			while (!t.empty() and t[0] == '.')
+				t.remove_prefix(1);
+			if (t.empty())
+				continue;
+		}
+		return t;
+	}
+}
+
+PGNReplay PGNReader::replay(const PGNGame& game, Chessboard& board) {
+	PGNReplay r;
+	if (std::string_view fen = game.tag("FEN"); !fen.empty()) {
+		if ((r.status = board.tryFromFEN(fen)) != Status::Ok) {
+			board.clear();
+			return r;
+		}
+	} else {
+		board.clear();
+		board.fill();
+	}
+
+	std::string_view movetext = game.movetext;
+	Move m;
+	for (std::string_view san = nextSAN(movetext); !san.empty(); san = nextSAN(movetext)) {
+		if ((r.status = board.findSAN(san, m)) != Status::Ok) {
+			r.san = san;
+			return r;
+		}
+		board.applyMove(m);
+		r.plies++;
+	}
+	return r;
+}
+
+Status Chessboard::findSAN(std::string_view san, Move& move) const {
+	move = Move();
+	while (!san.empty() and std::string_view("+#!?").find(san.back()) != std::string_view::npos)
+		san.remove_suffix(1);
+	if (san.empty())
+		return Status::BadSan;
+	if (!c_currentKing)
+		return Status::NoKing;
+
+	int castling = -1;
+	if (san == "O-O" or san == "0-0")
+		castling = Move::KingCastle;
+	else if (san == "O-O-O" or san == "0-0-0")
+		castling = Move::QueenCastle;
+
+	PieceType type = PieceType::Pawn;
+	int to = 0, fromX = 0, fromY = 0, promotion = -1;
+	if (castling < 0) {
+		if (pieceLetter(san[0], type))
+			san.remove_prefix(1);
+
+		PieceType promoteTo;
+		if (type == PieceType::Pawn and !san.empty() and pieceLetter(san.back(), promoteTo)) {
+			if (promoteTo == PieceType::King)
+				return Status::BadSan;
+			promotion = State::index(promoteTo);
+			san.remove_suffix(1);
+			if (!san.empty() and san.back() == '=')
+				san.remove_suffix(1);
+		}
+
+		if (san.size() < 2)
+			return Status::BadSan;
+		char file = san[san.size() - 2], rank = san.back();
+		if (file < 'a' or file > 'h' or rank < '1' or rank > '8')
+			return Status::BadSan;
+		to = square(file - 'a' + 1, rank - '0');
+		san.remove_suffix(2);
+
+		// disambiguation, capture and long algebraic notation marks
+		for (char c : san) {
+			if (c >= 'a' and c <= 'h' and !fromX and !fromY)
+				fromX = c - 'a' + 1;
+			else if (c >= '1' and c <= '8' and !fromY)
+				fromY = c - '0';
+			else if (c != 'x' and c != ':' and c != '-')
+				return Status::BadSan;
+		}
+		// pawn moves without file are pushes
+		if (type == PieceType::Pawn and !fromX)
+			fromX = squareX(to);
+	}
+
+	MoveList list;
+	c_state.generateLegal(list, b_currentTurnColor);
+	Move found;
+	for (Move m : list) {
+		if (castling >= 0) {
+			if (m.flags() != castling)
+				continue;
+		} else if (m.to() != to or m.castling() or c_state.type(m.from()) != type or
+			(fromX and squareX(m.from()) != fromX) or
+			(fromY and squareY(m.from()) != fromY) or
+			m.promotion() != (promotion >= 0) or
+			(m.promotion() and State::index(m.promoteTo()) != promotion)) {
+			continue;
+		}
+		if (found)
+			return Status::AmbiguousMove;
+		found = m;
+	}
+
+	if (!found)
+		return Status::NoSuchMove;
+	move = found;
+	return Status::Ok;
+}
+
+}
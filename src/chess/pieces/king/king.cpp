@@ -1,55 +1,53 @@
 #include <tartan/chess.hpp>
-
-#include <algorithm>
+#include <tartan/board/attacks.hpp>
 
 namespace tt::chess {
 using Position = Piece::Position;
 using TurnMap = Piece::TurnMap;
-
-TurnMap King::moveMap(int mode) const {
-	TurnMap map, m;
-	Position tpos, pos = p_position;
-	Piece* enemy;
-
-	if (p_color == Piece::Color::Black) {
-		pos.setMode(Position::Mode::Reverse);
-		tpos.setMode(Position::Mode::Reverse);
-	}
-
-	std::pair<int, int> ofs[8] = {
-	 {1, 1}, {1, 0}, {1, -1}, {0, -1},
-	 {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}
-	};
-
-	for (auto& of : ofs) {
-		try {
-			tpos = pos.offset(of.first, of.second);
-		} catch (std::out_of_range& ex) {
-			continue;
-		}
-		enemy = p_board->at(tpos);
-		if (enemy and enemy->color() != p_color)
-			map.push_front(new Turn(this, tpos, enemy));
+using Color = Piece::Color;
+
+namespace {
+
+template<Color C>
+TurnMap kingMoves(const King* k, int mode) {
+	constexpr const Steps<8>& steps = kingMoveSteps[static_cast<int>(C)];
+	constexpr int d = C == Color::White ? 1 : -1;
+	constexpr int bottom = C == Color::White ? 1 : 8;
+	constexpr Color enemyColor = C == Color::White ? Color::Black : Color::White;
+
+	TurnMap map;
+	const Board* b = k->board();
+	const Position& pos = k->position();
+	int sq = pos.square().index();
+	const Piece* enemy;
+
+	for (int i = 0; i < steps.count[sq]; i++) {
+		Position tpos(steps.to[sq][i]);
+		enemy = b->at(tpos);
+		if (enemy and enemy->color() != C)
+			map.push_front(new King::Turn(k, tpos, enemy));
 		else if (!enemy)
-			map.push_front(new Turn(this, tpos));
+			map.push_front(new King::Turn(k, tpos));
 	}
 
 	if (mode != Chessboard::CheckingMode and 
-		!k_castled and (movesMade() == 0) and 
+		!k->castled() and (k->movesMade() == 0) and 
 		(pos.letter() == 'e') and 
-		pos.atBottom() and !check()) {
-		bool valid = false;
-		Rook* rook;
-		int variants[2] = {1, -1};
-		for (auto v : variants) {			tpos = pos;
+		pos.y() == bottom and !k->check()) {
+		const Chessboard* cb = static_cast<const Chessboard*>(b);
+		const Rook* rook;
+		constexpr int variants[2] = {d, -d};
+		for (auto v : variants) {
+			bool valid = false;
+			Position tpos = pos;
 			while (true) {
-				try {
-					tpos = tpos(v, 0);
-				} catch (std::out_of_range& ex) {
+				std::optional<Position> next = tpos.tryOffset(v, 0);
+				if (!next)
 					break;
-				}
-				Piece* target = p_board->at(tpos);
-				rook = dynamic_cast<Rook*>(target);
+				tpos = *next;
+				const Piece* target = b->at(tpos);
+				rook = target and target->type() == State::index(PieceType::Rook) ?
+					static_cast<const Rook*>(target) : nullptr;
 				if (rook and rook->movesMade() == 0) {
 					valid = true;
 					break;
@@ -57,59 +55,35 @@ TurnMap King::moveMap(int mode) const {
 					break;
 				}
 			}
-			if (valid) {
-				Turn t(this, pos(v, 0));
-				t.apply();
-				bool c = check();
-				t.undo();
-				if (!c)
-					map.push_front(new Turn(this, pos(2*v, 0), nullptr, new Rook::Turn(rook, pos(v, 0))));
-			}
+			if (valid and !cb->isSquareAttacked(pos(v, 0), enemyColor))
+				map.push_front(new King::Turn(k, pos(2*v, 0), nullptr, new Rook::Turn(rook, pos(v, 0))));
 		}
 	}
 
 	return map;
 }
 
-bool King::check() const {
-	if (k_checkTurnIndex != board()->turnIndex()) {
-		k_check = calculateCheck();
-		k_checkTurnIndex = board()->turnIndex();
-	}
-	return k_check;
 }
 
-bool King::calculateCheck() const {
-	for (auto& row : p_board->board()) {
-		for (auto& p : row) {
-			if (!p or p->color() == p_color)
-				continue;
-			TurnMap enemyTurns = p->moveMap(
-				dynamic_cast<King*>(p) ? 
-				Chessboard::CheckingMode : 
-				Chessboard::DefaultMode
-			);
-
-			TurnMap::iterator e = std::find_if(
-				enemyTurns.begin(), 
-				enemyTurns.end(), 
-				[this](Piece::Turn* t){
-					return (t->capture() == this);
-				}
-			);
-
-			if (e != enemyTurns.end())
-				return true;
-		}
-	}
-	return false;
+TurnMap King::moveMap(int mode) const {
+	return p_color == Color::White ? 
+		kingMoves<Color::White>(this, mode) : kingMoves<Color::Black>(this, mode);
 }
 
+bool King::check() const {
+	return static_cast<const Chessboard*>(p_board)->isSquareAttacked(
+		p_position, 
+		p_color == Color::White ? Color::Black : Color::White
+	);
+}
 
 bool King::checkmate() const {
-	if (k_checkmateTurnIndex != board()->turnIndex()) {
+	// turn index is reused after Board::undoTurn(), so the cache is keyed by position
+	std::uint64_t hash = static_cast<const Chessboard*>(p_board)->hash();
+	if (!k_checkmateKnown or k_checkmateHash != hash) {
 		k_checkmate = calculateCheckmate();
-		k_checkmateTurnIndex = board()->turnIndex();
+		k_checkmateHash = hash;
+		k_checkmateKnown = true;
 	}
 	return k_checkmate;
 }
@@ -118,20 +92,29 @@ bool King::calculateCheckmate() const {
 	if (!check() or p_board->possibleMoves(this).possible())
 		return false;
 
-	for (auto& row : p_board->board()) {
-		for (auto& p : row) {
-			if (!p or p->color() != p_color or p == this)
-				continue;
-			TurnMap allyTurns = p->moveMap();
-
-			for (auto const& t : allyTurns) {
-				t->apply(true);
-				bool underCheck = check();
-				t->undo();
-				if (!underCheck)
-					return false;
-			}
-		}
+	const State& s = static_cast<const Chessboard*>(p_board)->state();
+	MoveList allyMoves;
+	s.generate(allyMoves, p_color);
+
+	int sq = square(p_position.x(), p_position.y());
+	for (Move m : allyMoves) {
+		if (m.from() == sq)
+			continue;
+
+		int capture = m.to();
+		if (m.enPassant())
+			capture += p_color == Color::White ? -8 : 8;
+
+		Piece::Turn t(
+			p_board->at({squareX(m.from()), squareY(m.from())}),
+			{squareX(m.to()), squareY(m.to())},
+			p_board->at({squareX(capture), squareY(capture)})
+		);
+		t.apply(Chessboard::CheckingMode);
+		bool underCheck = check();
+		t.undo();
+		if (!underCheck)
+			return false;
 	}
 
 	return true;
@@ -25,17 +25,27 @@ void Turn::apply(int) {
 
 	if (k_castlingTurn) {
 		k_castlingTurn->apply();
-		dynamic_cast<King*>(t_piece)->k_castled = true;
+		static_cast<King*>(t_piece)->k_castled = true;
 	}
 }
 
 void Turn::undo() {
-	Piece::Turn::undo();
-
 	if (k_castlingTurn) {
 		k_castlingTurn->undo();
-		dynamic_cast<King*>(t_piece)->k_castled = false;
+		static_cast<King*>(t_piece)->k_castled = false;
 	}
+
+	Piece::Turn::undo();
+}
+
+Turn* Turn::clone() const {
+	return new Turn(*this);
+}
+
+void Turn::relink(const std::function<Piece*(const Piece*)>& map) {
+	Piece::Turn::relink(map);
+	if (k_castlingTurn)
+		k_castlingTurn->relink(map);
 }
 
 std::string Turn::str() const {
@@ -1,38 +1,39 @@
 #include <tartan/chess.hpp>
+#include <tartan/board/attacks.hpp>
 
 namespace tt::chess {
 using Position = Piece::Position;
 using TurnMap = Piece::TurnMap;
+using Color = Piece::Color;
 
-TurnMap Knight::moveMap(int) const {
-	TurnMap map;
-	Position tpos, pos = p_position;
-	Piece* enemy;
+namespace {
 
-	if (p_color == Piece::Color::Black) {
-		pos.setMode(Position::Mode::Reverse);
-		tpos.setMode(Position::Mode::Reverse);
-	}
+template<Color C>
+TurnMap knightMoves(const Knight* n) {
+	constexpr const Steps<8>& steps = knightMoveSteps[static_cast<int>(C)];
+
+	TurnMap map;
+	const Board* b = n->board();
+	int sq = n->position().square().index();
+	const Piece* enemy;
 
-	std::pair<int, int> ofs[8] = {
-		{-2,  1}, {-1,  2}, {1,  2}, {2,  1},
-		{-2, -1}, {-1, -2}, {1, -2}, {2, -1},
-	};
-
-	for (auto& of : ofs) {
-		try {
-			tpos = pos.offset(of.first, of.second);
-		} catch (std::out_of_range& ex) {
-			continue;
-		}
-		enemy = p_board->at(tpos);
-		if (enemy and enemy->color() != p_color)
-			map.push_front(new Turn(this, tpos, enemy));
+	for (int i = 0; i < steps.count[sq]; i++) {
+		Position tpos(steps.to[sq][i]);
+		enemy = b->at(tpos);
+		if (enemy and enemy->color() != C)
+			map.push_front(new Knight::Turn(n, tpos, enemy));
 		else if (!enemy)
-			map.push_front(new Turn(this, tpos));
+			map.push_front(new Knight::Turn(n, tpos));
 	}
 
 	return map;
 }
 
 }
+
+TurnMap Knight::moveMap(int) const {
+	return p_color == Color::White ? 
+		knightMoves<Color::White>(this) : knightMoves<Color::Black>(this);
+}
+
+}
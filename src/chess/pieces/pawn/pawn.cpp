@@ -3,69 +3,79 @@
 namespace tt::chess {
 using Position = Piece::Position;
 using TurnMap = Piece::TurnMap;
+using Color = Piece::Color;
 
-TurnMap Pawn::moveMap(int) const {
-	TurnMap map;
-	Position tpos, pos = p_position;
-	Pawn* enemy_pawn;
-	Piece* enemy;
+namespace {
 
-	if (p_color == Piece::Color::Black) {
-		pos.setMode(Position::Mode::Reverse);
-		tpos.setMode(Position::Mode::Reverse);
+// pushes the turn, or turn for every promotion piece if `to` is the top tile
+template<int Top>
+void push(TurnMap& map, const Pawn* p, const Position& to, const Piece* capture = nullptr) {
+	if (to.y() != Top) {
+		map.push_front(new Pawn::Turn{p, to, capture});
+		return;
 	}
 
-	tpos = pos(0, 1);
+	for (PieceType t : {PieceType::Knight, PieceType::Rook, PieceType::Bishop, PieceType::Queen})
+		map.push_front(new Pawn::Turn{p, to, capture, promotionType(t)});
+}
+
+template<Color C>
+TurnMap pawnMoves(const Pawn* p) {
+	// black pawns move down the board, left and right are mirrored
+	constexpr int up = C == Color::White ? 1 : -1;
+	constexpr int top = C == Color::White ? 8 : 1;
+	// the only rank where enemy pawn could have just skipped a tile
+	constexpr int fifth = C == Color::White ? 5 : 4;
+	constexpr int sides[2] = {-up, up};
+
+	TurnMap map;
+	const Board* b = p->board();
+	const Position& pos = p->position();
+	const Piece* enemy;
+
+	std::optional<Position> front = pos.tryOffset(0, up);
+	if (!front)
+		return map;
+
 	// front piece
-	if (!p_board->at(tpos)) {
-		map.push_front(new Turn{this, tpos});
+	if (!b->at(*front)) {
+		push<top>(map, p, *front);
 		// two cell turn
-		if (movesMade() == 0) {
-			tpos = tpos(0, 1);
-			if (!p_board->at(tpos)) {
-				map.push_front(new Turn{this, tpos}); 
-			}
+		if (p->movesMade() == 0 and front->y() != top) {
+			Position tpos = front->offset(0, up);
+			if (!b->at(tpos))
+				map.push_front(new Pawn::Turn{p, tpos}); 
 		}
 	}
 
-	// en passant left enemy
-	if (!pos.atLeft()) {
-		tpos = pos(-1, 0);
-		enemy_pawn = 
-			dynamic_cast<Pawn*>(p_board->at(tpos));
-		if (enemy_pawn and 
-			enemy_pawn->p_color != p_color and
-			enemy_pawn->movesMade() == 1 and
-			enemy_pawn->turnIndex() == p_board->turnIndex())
-			map.push_front(new Turn{this, tpos(0, 1), enemy_pawn});
-	}
-
-	// en passant right enemy
-	if (!pos.atRight()) {
-		tpos = pos(1, 0);
-		enemy_pawn = 
-			dynamic_cast<Pawn*>(p_board->at(tpos));
-		if (enemy_pawn and 
-			enemy_pawn->p_color != p_color and
-			enemy_pawn->movesMade() == 1 and
-			enemy_pawn->turnIndex() == p_board->turnIndex())
-			map.push_front(new Turn{this, tpos(0, 1), enemy_pawn});
+	// en passant left and right enemy
+	for (int side : sides) {
+		std::optional<Position> tpos = pos.tryOffset(side, 0);
+		if (!tpos)
+			continue;
+		enemy = b->at(*tpos);
+		if (pos.y() == fifth and enemy and enemy->type() == p->type() and 
+			enemy->color() != C and
+			enemy->movesMade() == 1 and
+			enemy->turnIndex() == b->turnIndex())
+			map.push_front(new Pawn::Turn{p, tpos->offset(0, up), enemy});
 	}
 
 	// defeat left/right pawn
-	if (!pos.atLeft()) {
-		tpos = pos(-1, 1);
-		if ((enemy = p_board->at(tpos)) and enemy->color() != p_color)
-			map.push_front(new Turn{this, tpos, enemy});
-	}
-	if (!pos.atRight()) {
-		tpos = pos(1, 1);
-		if ((enemy = p_board->at(tpos)) and enemy->color() != p_color) {
-			map.push_front(new Turn{this, tpos, enemy});
-		}
+	for (int side : sides) {
+		std::optional<Position> tpos = front->tryOffset(side, 0);
+		if (tpos and (enemy = b->at(*tpos)) and enemy->color() != C)
+			push<top>(map, p, *tpos, enemy);
 	}
 
 	return map;
 }
 
 }
+
+TurnMap Pawn::moveMap(int) const {
+	return p_color == Color::White ? 
+		pawnMoves<Color::White>(this) : pawnMoves<Color::Black>(this);
+}
+
+}
@@ -10,35 +10,31 @@ void Turn::apply(int mode) {
 	Position pos = t_to;
 	if (t_piece->color() == Color::Black)
 		pos.setMode(Position::Mode::Reverse);
-
-	t_promoteTo = typeid(nullptr);
-	if (pos.atTop() and mode != Chessboard::CheckingMode) {
-		Board* cb = t_piece->board();
-		t_promoteTo = cb->getPieceType({
+	if (!pos.atTop())
+		return;
+
+	Chessboard* cb = static_cast<Chessboard*>(t_piece->board());
+	if (t_promoteTo == typeid(nullptr)) {
+		if (mode == Chessboard::CheckingMode)
+			return;
+		std::type_index type = cb->getPieceType({
 			typeid(Queen), typeid(Bishop), typeid(Rook), typeid(Knight)
 		});
-
-		Piece* tmp = cb->at(pos);
-		Piece* newPiece;
-		cb->at(pos) = nullptr;
-		if (t_promoteTo == typeid(Queen))
-			newPiece = new Queen(pos, t_piece->color());
-		else if (t_promoteTo == typeid(Bishop))
-			newPiece = new Bishop(pos, t_piece->color());
-		else if (t_promoteTo == typeid(Rook))
-			newPiece = new Rook(pos, t_piece->color());
-		else if (t_promoteTo == typeid(Knight))
-			newPiece = new Knight(pos, t_piece->color());
-		else {
-			t_promoteTo = typeid(nullptr);
-			cb->at(pos) = tmp;
-			throw tt::ex::bad_piece_type();
-		}
-		cb->insertPiece(newPiece);
-		delete tmp;
+		cb->promote(t_piece, type);
+		t_promoteTo = type;
+	} else {
+		cb->promote(t_piece, t_promoteTo);
 	}
 }
 
+void Turn::undo() {
+	// pawn is off the board only if it was promoted
+	if (t_piece->board()->at(t_to) != t_piece)
+		static_cast<Chessboard*>(t_piece->board())->demote(t_piece);
+
+	Piece::Turn::undo();
+}
+
 bool Turn::isEqual(const Piece::Turn& rhs) const {
 	const Pawn::Turn* crhs = dynamic_cast<const Pawn::Turn*>(&rhs);
 	if (!crhs)
@@ -47,5 +43,9 @@ bool Turn::isEqual(const Piece::Turn& rhs) const {
 	return Piece::Turn::isEqual(rhs) and t_promoteTo == crhs->t_promoteTo;
 }
 
+Turn* Turn::clone() const {
+	return new Turn(*this);
+}
+
 
 }
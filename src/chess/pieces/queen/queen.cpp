@@ -5,14 +5,9 @@ using Position = Piece::Position;
 using TurnMap = Piece::TurnMap;
 
 TurnMap Queen::moveMap(int) const {
-	TurnMap map, m;
-
-	map = Piece::diagonalMoves(this);
-	m = Piece::straightMoves(this); 
-	map.insert(
-		map.begin(), m.begin(), m.end()
-	);
-	m.clear();
+	TurnMap map = Piece::diagonalMoves(this);
+	TurnMap m = Piece::straightMoves(this); 
+	map.splice(map.begin(), m);
 
 	return map;
 }
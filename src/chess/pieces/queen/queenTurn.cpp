@@ -12,5 +12,8 @@ bool Turn::isEqual(const Piece::Turn& rhs) const {
 	return Piece::Turn::isEqual(rhs);
 }
 
+Turn* Turn::clone() const {
+	return new Turn(*this);
+}
 
 }
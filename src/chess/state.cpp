@@ -0,0 +1,380 @@
+#include <tartan/chess/state.hpp>
+#include <tartan/board/attacks.hpp>
+
+#include <algorithm>
+
+namespace tt::chess {
+
+namespace {
+
+void pushPromotions(MoveList& list, int from, int to, int flags) {
+	for (int p = Move::QueenPromotion; p >= Move::KnightPromotion; p--)
+		list.push_back(Move(from, to, p | flags));
+}
+
+template<int Shift>
+constexpr Bitboard shift(Bitboard b) {
+	return Shift > 0 ? b << Shift : b >> -Shift;
+}
+
+template<int Shift>
+void pushPawnMoves(MoveList& list, Bitboard targets, int flags) {
+	while (targets) {
+		int to = popLsb(targets);
+		if (to >= 56 or to < 8)
+			pushPromotions(list, to - Shift, to, flags);
+		else
+			list.push_back(Move(to - Shift, to, flags));
+	}
+}
+
+void pushMoves(MoveList& list, int from, Bitboard targets, Bitboard enemy) {
+	while (targets) {
+		int to = popLsb(targets);
+		list.push_back(Move(from, to, (enemy & bit(to)) ? Move::Capture : Move::Quiet));
+	}
+}
+
+// direction constants are resolved at compile time for each color
+template<Piece::Color C>
+void generateMoves(const State& s, MoveList& list) {
+	constexpr bool white = C == Piece::Color::White;
+	constexpr Piece::Color them = white ? Piece::Color::Black : Piece::Color::White;
+	constexpr int forward = white ? 8 : -8;
+	constexpr Bitboard third = white ? rank1 << 16 : rank8 >> 16;
+	constexpr Bitboard sixth = white ? rank1 << 40 : rank1 << 16;
+	constexpr int king = white ? square(5, 1) : square(5, 8);
+	constexpr int kingside = white ? State::WhiteKingside : State::BlackKingside;
+	constexpr int queenside = white ? State::WhiteQueenside : State::BlackQueenside;
+
+	Bitboard own = s.occupancy(C), enemy = s.occupancy(them);
+	Bitboard all = own | enemy, empty = ~all;
+
+	Bitboard pawns = s.pieces(C, PieceType::Pawn);
+	Bitboard single = shift<forward>(pawns) & empty;
+	pushPawnMoves<forward>(list, single, Move::Quiet);
+	pushPawnMoves<2*forward>(list, shift<forward>(single & third) & empty, Move::DoublePush);
+	pushPawnMoves<forward - 1>(list, shift<forward - 1>(pawns & ~fileA) & enemy, Move::Capture);
+	pushPawnMoves<forward + 1>(list, shift<forward + 1>(pawns & ~fileH) & enemy, Move::Capture);
+	int to = s.enPassant();
+	if (to >= 0 and (bit(to) & sixth)) {
+		if (squareX(to) > 1 and (pawns & bit(to - forward - 1)))
+			list.push_back(Move(to - forward - 1, to, Move::EnPassant));
+		if (squareX(to) < 8 and (pawns & bit(to - forward + 1)))
+			list.push_back(Move(to - forward + 1, to, Move::EnPassant));
+	}
+
+	Bitboard pieces = s.pieces(C, PieceType::Knight);
+	while (pieces) {
+		int from = popLsb(pieces);
+		pushMoves(list, from, knightAttacks(from) & ~own, enemy);
+	}
+
+	pieces = s.pieces(C, PieceType::Bishop);
+	while (pieces) {
+		int from = popLsb(pieces);
+		pushMoves(list, from, bishopAttacks(from, all) & ~own, enemy);
+	}
+
+	pieces = s.pieces(C, PieceType::Rook);
+	while (pieces) {
+		int from = popLsb(pieces);
+		pushMoves(list, from, rookAttacks(from, all) & ~own, enemy);
+	}
+
+	pieces = s.pieces(C, PieceType::Queen);
+	while (pieces) {
+		int from = popLsb(pieces);
+		pushMoves(list, from, queenAttacks(from, all) & ~own, enemy);
+	}
+
+	pieces = s.pieces(C, PieceType::King);
+	while (pieces) {
+		int from = popLsb(pieces);
+		pushMoves(list, from, kingAttacks(from) & ~own, enemy);
+	}
+
+	if ((s.castling() & kingside) and 
+		!(all & (bit(king + 1) | bit(king + 2))))
+		list.push_back(Move(king, king + 2, Move::KingCastle));
+	if ((s.castling() & queenside) and 
+		!(all & (bit(king - 1) | bit(king - 2) | bit(king - 3))))
+		list.push_back(Move(king, king - 2, Move::QueenCastle));
+}
+
+struct Zobrist {
+	constexpr Zobrist() {
+		std::uint64_t seed = 0x7A27A2ULL;
+		auto next = [&seed]() {
+			std::uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		};
+		for (auto& c : pieces)
+			for (auto& t : c)
+				for (auto& k : t)
+					k = next();
+		side = next();
+		for (auto& k : file)
+			k = next();
+		std::uint64_t rights[4] = {next(), next(), next(), next()};
+		for (int c = 0; c < 16; c++)
+			for (int r = 0; r < 4; r++)
+				if (c & (1 << r))
+					castling[c] ^= rights[r];
+	}
+
+	std::uint64_t pieces[2][6][64] = {};
+	std::uint64_t side = 0;
+	std::uint64_t castling[16] = {};
+	std::uint64_t file[8] = {};
+};
+
+constexpr Zobrist zobrist;
+
+Bitboard between(int a, int b) {
+	for (int d = 0; d < 8; d++)
+		if (ray(Direction(d), a) & bit(b))
+			return ray(Direction(d), a) & ~ray(Direction(d), b) & ~bit(b);
+	return 0;
+}
+
+Bitboard line(int a, int b) {
+	for (int d = 0; d < 8; d++)
+		if (ray(Direction(d), a) & bit(b))
+			return ray(Direction(d), a);
+	return 0;
+}
+
+// castling rights left after a piece leaves or enters the tile
+const std::uint8_t castlingMask[64] = {
+	13, 15, 15, 15, 12, 15, 15, 14,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	 7, 15, 15, 15,  3, 15, 15, 11,
+};
+
+}
+
+PieceType State::type(int sq) const {
+	const Bitboard* row = s_pieces[index(color(sq))];
+	Bitboard b = bit(sq);
+	int t = 0;
+	while (!(row[t] & b))
+		t++;
+	return static_cast<PieceType>(t);
+}
+
+void State::put(int sq, Piece::Color c, PieceType t) {
+	Bitboard b = bit(sq);
+	s_hash ^= zobrist.pieces[index(c)][index(t)][sq];
+	s_pieces[index(c)][index(t)] |= b;
+	s_occupancy[index(c)] |= b;
+}
+
+void State::remove(int sq) {
+	Bitboard b = bit(sq);
+	int c = index(color(sq)), t = index(type(sq));
+	s_hash ^= zobrist.pieces[c][t][sq];
+	s_pieces[c][t] &= ~b;
+	s_occupancy[c] &= ~b;
+}
+
+void State::move(int from, int to) {
+	Bitboard b = bit(from) | bit(to);
+	int c = index(color(from)), t = index(type(from));
+	s_hash ^= zobrist.pieces[c][t][from] ^ zobrist.pieces[c][t][to];
+	s_pieces[c][t] ^= b;
+	s_occupancy[c] ^= b;
+}
+
+void State::clear() {
+	*this = State();
+}
+
+void State::setSide(Piece::Color c) {
+	if (c != s_side)
+		s_hash ^= zobrist.side;
+	s_side = c;
+}
+
+void State::setCastling(int c) {
+	s_hash ^= zobrist.castling[s_castling] ^ zobrist.castling[c];
+	s_castling = static_cast<std::uint8_t>(c);
+}
+
+void State::setEnPassant(int sq) {
+	// the pawn that skipped a rank 3 tile is white, so black captures it
+	if (sq >= 0) {
+		Piece::Color by = squareY(sq) == 3 ? Piece::Color::Black : Piece::Color::White;
+		Piece::Color moved = by == Piece::Color::White ? Piece::Color::Black : Piece::Color::White;
+		if (!(pawnAttacks(moved, sq) & pieces(by, PieceType::Pawn)))
+			sq = -1;
+	}
+	if (s_enPassant >= 0)
+		s_hash ^= zobrist.file[squareX(s_enPassant) - 1];
+	if (sq >= 0)
+		s_hash ^= zobrist.file[squareX(sq) - 1];
+	s_enPassant = static_cast<std::int8_t>(sq);
+}
+
+Bitboard State::attackersOf(int sq, Bitboard occupancy) const {
+	const Bitboard (&w)[6] = s_pieces[index(Piece::Color::White)];
+	const Bitboard (&b)[6] = s_pieces[index(Piece::Color::Black)];
+	int pawn = index(PieceType::Pawn), knight = index(PieceType::Knight),
+		bishop = index(PieceType::Bishop), rook = index(PieceType::Rook),
+		queen = index(PieceType::Queen), king = index(PieceType::King);
+
+	return
+		(pawnAttacks(Piece::Color::Black, sq) & w[pawn]) |
+		(pawnAttacks(Piece::Color::White, sq) & b[pawn]) |
+		(knightAttacks(sq) & (w[knight] | b[knight])) |
+		(kingAttacks(sq) & (w[king] | b[king])) |
+		(bishopAttacks(sq, occupancy) & (w[bishop] | b[bishop] | w[queen] | b[queen])) |
+		(rookAttacks(sq, occupancy) & (w[rook] | b[rook] | w[queen] | b[queen]));
+}
+
+bool State::isSquareAttacked(int sq, Piece::Color by) const {
+	const Bitboard (&p)[6] = s_pieces[index(by)];
+	Piece::Color enemy = by == Piece::Color::White ? 
+		Piece::Color::Black : Piece::Color::White;
+	Bitboard all = occupancy();
+
+	return
+		(pawnAttacks(enemy, sq) & p[index(PieceType::Pawn)]) or
+		(knightAttacks(sq) & p[index(PieceType::Knight)]) or
+		(kingAttacks(sq) & p[index(PieceType::King)]) or
+		(bishopAttacks(sq, all) & 
+			(p[index(PieceType::Bishop)] | p[index(PieceType::Queen)])) or
+		(rookAttacks(sq, all) & 
+			(p[index(PieceType::Rook)] | p[index(PieceType::Queen)]));
+}
+
+bool State::hasPossibleMaterial(Piece::Color c) const {
+	auto count = [&](PieceType t) { return popcount(pieces(c, t)); };
+	auto extra = [&](PieceType t, int initial) { return std::max(count(t) - initial, 0); };
+	int pawns = count(PieceType::Pawn);
+	int promoted = extra(PieceType::Knight, 2) + extra(PieceType::Bishop, 2) +
+		extra(PieceType::Rook, 2) + extra(PieceType::Queen, 1);
+	return popcount(occupancy(c)) <= 16 and pawns <= 8 and promoted <= 8 - pawns;
+}
+
+void State::generate(MoveList& list, Piece::Color c) const {
+	if (c == Piece::Color::White)
+		generateMoves<Piece::Color::White>(*this, list);
+	else
+		generateMoves<Piece::Color::Black>(*this, list);
+}
+
+State::CheckInfo State::checkInfo(Piece::Color c) const {
+	int us = index(c), them = !us;
+	Bitboard own = s_occupancy[us], all = occupancy();
+	const Bitboard (&p)[6] = s_pieces[them];
+
+	CheckInfo ci;
+	ci.king = lsb(s_pieces[us][index(PieceType::King)]);
+	ci.checkers = attackersOf(ci.king, all) & s_occupancy[them];
+	ci.pinned = 0;
+
+	Bitboard snipers = 
+		(bishopAttacks(ci.king, s_occupancy[them]) & 
+			(p[index(PieceType::Bishop)] | p[index(PieceType::Queen)])) |
+		(rookAttacks(ci.king, s_occupancy[them]) & 
+			(p[index(PieceType::Rook)] | p[index(PieceType::Queen)]));
+	while (snipers) {
+		Bitboard b = between(ci.king, popLsb(snipers)) & all;
+		if (b and !(b & (b - 1)) and (b & own))
+			ci.pinned |= b;
+	}
+
+	if (!ci.checkers)
+		ci.evasions = ~Bitboard(0);
+	else if (ci.checkers & (ci.checkers - 1))
+		ci.evasions = 0;
+	else
+		ci.evasions = ci.checkers | between(ci.king, lsb(ci.checkers));
+
+	return ci;
+}
+
+bool State::isLegal(Move m, const CheckInfo& ci) const {
+	int from = m.from(), to = m.to();
+	Bitboard enemy = s_occupancy[!index(color(from))];
+
+	if (from == ci.king) {
+		if (m.castling()) {
+			if (ci.checkers or
+				isSquareAttacked((from + to)/2, color(from) == Piece::Color::White ?
+					Piece::Color::Black : Piece::Color::White))
+				return false;
+		}
+		Bitboard occupancy = this->occupancy() ^ bit(from);
+		return !(attackersOf(to, occupancy) & enemy & ~bit(to));
+	}
+
+	if (m.enPassant()) {
+		int captured = squareY(from) == 5 ? to - 8 : to + 8;
+		Bitboard occupancy = (this->occupancy() ^ bit(from) ^ bit(captured)) | bit(to);
+		return !(attackersOf(ci.king, occupancy) & enemy & ~bit(captured));
+	}
+
+	if ((ci.pinned & bit(from)) and !(line(ci.king, from) & bit(to)))
+		return false;
+
+	return ci.evasions & bit(to);
+}
+
+void State::generateLegal(MoveList& list, Piece::Color c) const {
+	MoveList pseudo;
+	generate(pseudo, c);
+	CheckInfo ci = checkInfo(c);
+	for (Move m : pseudo)
+		if (isLegal(m, ci))
+			list.push_back(m);
+}
+
+void State::makeMove(Move m) {
+	int from = m.from(), to = m.to();
+
+	if (m.enPassant())
+		remove(s_side == Piece::Color::White ? to - 8 : to + 8);
+	else if (m.capture())
+		remove(to);
+
+	move(from, to);
+
+	if (m.promotion()) {
+		remove(to);
+		put(to, s_side, m.promoteTo());
+	} else if (m.flags() == Move::KingCastle) {
+		move(to + 1, to - 1);
+	} else if (m.flags() == Move::QueenCastle) {
+		move(to - 2, to + 1);
+	}
+
+	setCastling(s_castling & castlingMask[from] & castlingMask[to]);
+	setEnPassant(m.flags() == Move::DoublePush ? (from + to)/2 : -1);
+	setSide(s_side == Piece::Color::White ? 
+		Piece::Color::Black : Piece::Color::White);
+}
+
+bool operator==(const State& lhs, const State& rhs) {
+	for (int c = 0; c < 2; c++)
+		for (int t = 0; t < 6; t++)
+			if (lhs.s_pieces[c][t] != rhs.s_pieces[c][t])
+				return false;
+	return lhs.s_side == rhs.s_side and 
+		lhs.s_castling == rhs.s_castling and 
+		lhs.s_enPassant == rhs.s_enPassant;
+}
+
+bool operator!=(const State& lhs, const State& rhs) {
+	return !(lhs == rhs);
+}
+
+}
@@ -0,0 +1,156 @@
+#include <tartan/chess/transposition.hpp>
+#include <tartan/board/status.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace tt::chess {
+
+namespace {
+
+// data bits: move 0-15, score 16-31, depth 32-39, bound 40-41, generation 42-47
+std::uint64_t pack(const TranspositionTable::Entry& e, std::uint8_t generation) {
+	return
+		static_cast<std::uint64_t>(e.move.raw()) |
+		static_cast<std::uint64_t>(static_cast<std::uint16_t>(e.score)) << 16 |
+		static_cast<std::uint64_t>(static_cast<std::uint8_t>(e.depth)) << 32 |
+		static_cast<std::uint64_t>(e.bound & 3) << 40 |
+		static_cast<std::uint64_t>(generation & 63) << 42;
+}
+
+int depth(std::uint64_t data) {
+	return static_cast<std::int8_t>((data >> 32) & 0xFF);
+}
+
+std::uint8_t generation(std::uint64_t data) {
+	return (data >> 42) & 63;
+}
+
+}
+
+TranspositionTable::TranspositionTable(std::size_t size) {
+	resize(size);
+}
+
+TranspositionTable::~TranspositionTable() {
+	release();
+}
+
+void TranspositionTable::resize(std::size_t size) {
+	release();
+
+	std::size_t count = 4;
+	while (count * 2 * sizeof(Slot) <= (size << 20))
+		count *= 2;
+
+	allocate(count * sizeof(Slot));
+	std::uninitialized_default_construct_n(t_slots, count);
+	t_mask = count - 1;
+	clear();
+}
+
+void TranspositionTable::clear() {
+	for (std::size_t i = 0; i <= t_mask; i++) {
+		t_slots[i].key.store(0, std::memory_order_relaxed);
+		t_slots[i].data.store(0, std::memory_order_relaxed);
+	}
+	t_generation = 0;
+}
+
+bool TranspositionTable::probe(std::uint64_t key, Entry& e) const {
+	const Slot& s = t_slots[key & t_mask];
+	std::uint64_t data = s.data.load(std::memory_order_relaxed);
+	if (!data or (s.key.load(std::memory_order_relaxed) ^ data) != key)
+		return false;
+
+	e.move = Move(data & 0x3F, (data >> 6) & 0x3F, (data >> 12) & 0xF);
+	e.score = static_cast<std::int16_t>((data >> 16) & 0xFFFF);
+	e.depth = static_cast<std::int8_t>(depth(data));
+	e.bound = static_cast<Bound>((data >> 40) & 3);
+	return true;
+}
+
+void TranspositionTable::store(std::uint64_t key, const Entry& e) {
+	Slot& s = t_slots[key & t_mask];
+	std::uint64_t old = s.data.load(std::memory_order_relaxed);
+	Entry entry = e;
+
+	if (old) {
+		bool same = (s.key.load(std::memory_order_relaxed) ^ old) == key;
+		if (generation(old) == t_generation and
+			e.bound != ExactBound and e.depth + 2 < depth(old))
+			return;
+		if (same and !e.move)
+			entry.move = Move(old & 0x3F, (old >> 6) & 0x3F, (old >> 12) & 0xF);
+	}
+
+	std::uint64_t data = pack(entry, t_generation);
+	s.key.store(key ^ data, std::memory_order_relaxed);
+	s.data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+	std::size_t count = t_mask + 1 < 1000 ? t_mask + 1 : 1000;
+	std::size_t used = 0;
+	for (std::size_t i = 0; i < count; i++) {
+		std::uint64_t data = t_slots[i].data.load(std::memory_order_relaxed);
+		if (data and generation(data) == t_generation)
+			used++;
+	}
+	return static_cast<int>(used * 1000 / count);
+}
+
+void TranspositionTable::allocate(std::size_t bytes) {
+	t_bytes = bytes;
+	t_huge = false;
+	void* p = nullptr;
+#if defined(__linux__)
+	const std::size_t page = 2 << 20;
+	if (bytes >= page) {
+		p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		t_huge = p != MAP_FAILED;
+	}
+	if (!t_huge) {
+		p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p == MAP_FAILED)
+			TARTAN_THROW(std::bad_alloc());
+#if defined(MADV_HUGEPAGE)
+		if (bytes >= page)
+			t_huge = madvise(p, bytes, MADV_HUGEPAGE) == 0;
+#endif
+	}
+#elif defined(_WIN32)
+	p = _aligned_malloc(bytes, 64);
+#else
+	p = std::aligned_alloc(64, bytes);
+#endif
+	if (!p)
+		TARTAN_THROW(std::bad_alloc());
+	t_slots = static_cast<Slot*>(p);
+}
+
+void TranspositionTable::release() {
+	if (!t_slots)
+		return;
+#if defined(__linux__)
+	munmap(t_slots, t_bytes);
+#elif defined(_WIN32)
+	_aligned_free(t_slots);
+#else
+	std::free(t_slots);
+#endif
+	t_slots = nullptr;
+	t_mask = 0;
+	t_bytes = 0;
+}
+
+}
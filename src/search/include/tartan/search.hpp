@@ -0,0 +1 @@
+#include "search/search.hpp"
@@ -0,0 +1,168 @@
+#ifndef _TARTAN_SEARCH_HPP_
+#define _TARTAN_SEARCH_HPP_
+
+#include <tartan/chess.hpp>
+#include <tartan/chess/transposition.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//! Chess position search namespace
+namespace tt::chess::search {
+
+//! Score of the position where side to move is checkmated
+constexpr int mateScore = 32000;
+//! Scores beyond this value mean forced checkmate
+constexpr int mateBound = mateScore - 256;
+//! Bigger than any score
+constexpr int infinity = mateScore + 1;
+
+/**
+ * @brief Static position evaluation
+ *
+ * Material and piece placement balance in centipawns
+ * from the State::side() point of view.
+ *
+ * @param s evaluated position
+ * @return position score
+ */
+int evaluate(const State& s);
+
+/**
+ * @brief Search stopping conditions
+ *
+ * Search is stopped by the first condition met.
+ * Zero values are not limiting.
+ */
+struct Limits {
+	//! Maximum iterative deepening depth
+	int depth = 64;
+	//! Maximum count of visited nodes
+	std::uint64_t nodes = 0;
+	//! Maximum search time
+	std::chrono::milliseconds time{0};
+};
+
+/**
+ * @brief Search result
+ */
+struct Result {
+	//! Best move found, null Move if there are no legal moves
+	Move bestMove;
+	/**
+	 * @brief Best move score
+	 *
+	 * Centipawns from the side to move point of view,
+	 * or the `mateScore - n` for the checkmate in
+	 * `n` plies (negative if side to move is mated).
+	 */
+	int score = 0;
+	//! Depth of the last completed iteration
+	int depth = 0;
+	//! Principal variation, starts with bestMove
+	std::vector<Move> pv;
+	//! Count of visited nodes
+	std::uint64_t nodes = 0;
+	//! Search time
+	std::chrono::milliseconds time{0};
+};
+
+/**
+ * @brief Alpha-beta chess position searcher
+ *
+ * Iterative deepening principal variation search with
+ * aspiration windows, transposition table,
+ * null move pruning and late move reductions.
+ * Leaf positions are resolved with the quiescence search
+ * of captures and scored with evaluate().
+ *
+ * Moves are generated and made on the State copies
+ * with State::generateLegal() and State::makeMove(), so
+ * searched Chessboard is not modified.
+ *
+ * Search may run on several threads (Lazy SMP): every
+ * thread searches its own copy of the position with its
+ * own move ordering tables, and threads share only the
+ * transposition table. Helper threads start iterative 
+ * deepening at staggered depths, so they fill the table
+ * with the positions the main thread will need next.
+ * Result is taken from the main thread.
+ *
+ * @sa Limits, Result
+ */
+class Searcher {
+public:
+	/**
+	 * @brief Construct new Searcher
+	 *
+	 * @param hashSize transposition table size in MiB
+	 * @param threads count of search threads
+	 */
+	explicit Searcher(std::size_t hashSize = 16, std::size_t threads = 1);
+	~Searcher();
+	/**
+	 * @brief Search the Chessboard position
+	 *
+	 * @param cb searched Chessboard, side to move is
+	 * Chessboard::currentTurn()
+	 * @param limits stopping conditions
+	 * @return search result
+	 */
+	Result search(const Chessboard& cb, const Limits& limits = {});
+	/**
+	 * @brief Search the position
+	 *
+	 * @param s searched position
+	 * @param limits stopping conditions
+	 * @return search result
+	 */
+	Result search(const State& s, const Limits& limits = {});
+	/**
+	 * @brief Stop the running search
+	 *
+	 * May be called from any thread. search() returns
+	 * the result of the last completed iteration.
+	 */
+	void stop() { s_stop = true; };
+	/**
+	 * @brief Transposition table used by search()
+	 *
+	 * @return searcher TranspositionTable
+	 */
+	TranspositionTable& table() { return s_table; };
+	/**
+	 * @brief Count of search threads
+	 *
+	 * @return count of threads search() runs, 
+	 * main thread included
+	 */
+	std::size_t threads() const { return s_workers.size(); };
+	/**
+	 * @brief Set count of search threads
+	 *
+	 * @warning Must not be called during search()
+	 *
+	 * @param count count of threads search() runs,
+	 * main thread included. 0 is treated as 1.
+	 */
+	void setThreads(std::size_t count);
+	//! Maximum search ply
+	static constexpr int maxPly = 128;
+private:
+	class Worker;
+	bool stopped() const;
+	std::uint64_t nodes() const;
+
+	TranspositionTable s_table;
+	std::vector<std::unique_ptr<Worker>> s_workers;
+	std::atomic<bool> s_stop{false};
+	Limits s_limits;
+	std::chrono::steady_clock::time_point s_start;
+};
+
+}
+
+#endif // !_TARTAN_SEARCH_HPP_
@@ -0,0 +1,388 @@
+#include <tartan/search.hpp>
+#include <tartan/chess/exceptions.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace tt::chess::search {
+using TT = TranspositionTable;
+
+namespace {
+
+const int values[6] = {100, 320, 330, 500, 900, 20000};
+
+Piece::Color enemy(Piece::Color c) {
+	return c == Piece::Color::White ? Piece::Color::Black : Piece::Color::White;
+}
+
+bool inCheck(const State& s) {
+	return s.isSquareAttacked(
+		lsb(s.pieces(s.side(), PieceType::King)), enemy(s.side())
+	);
+}
+
+// mate scores are stored relative to the node, not to the root
+int toTable(int score, int ply) {
+	if (score >= mateBound)
+		return score + ply;
+	if (score <= -mateBound)
+		return score - ply;
+	return score;
+}
+
+int fromTable(int score, int ply) {
+	if (score >= mateBound)
+		return score - ply;
+	if (score <= -mateBound)
+		return score + ply;
+	return score;
+}
+
+int reduction(int depth, int index) {
+	if (depth < 3 or index < 3)
+		return 0;
+	int r = 1 + (depth > 6) + (index > 10);
+	return std::min(r, depth - 2);
+}
+
+}
+
+class Searcher::Worker {
+public:
+	Worker(Searcher& searcher, std::size_t id) : w_searcher(searcher), w_id(id) {};
+	Result iterate(const State& root, int maxDepth);
+	void clear();
+	std::uint64_t nodes() const { return w_nodes.load(std::memory_order_relaxed); };
+private:
+	int pvs(const State& s, int depth, int alpha, int beta, int ply, bool nullMove);
+	int quiescence(const State& s, int alpha, int beta, int ply);
+	void order(const State& s, MoveList& list, Move best, int ply) const;
+	bool stopped();
+	void count() { w_nodes.store(nodes() + 1, std::memory_order_relaxed); };
+
+	Searcher& w_searcher;
+	std::size_t w_id;
+	std::atomic<std::uint64_t> w_nodes{0};
+	std::uint64_t w_path[maxPly + 1] = {};
+	Move w_pv[maxPly + 1][maxPly + 1];
+	int w_pvLength[maxPly + 1] = {};
+	Move w_killers[maxPly + 1][2];
+	int w_history[2][64][64] = {};
+};
+
+Searcher::Searcher(std::size_t hashSize, std::size_t threads) : s_table(hashSize) {
+	setThreads(threads);
+}
+
+Searcher::~Searcher() = default;
+
+void Searcher::setThreads(std::size_t count) {
+	s_workers.clear();
+	for (std::size_t i = 0; i < std::max<std::size_t>(count, 1); i++)
+		s_workers.push_back(std::make_unique<Worker>(*this, i));
+}
+
+Result Searcher::search(const Chessboard& cb, const Limits& limits) {
+	if (!cb.currentKing())
+		TARTAN_THROW(ex::no_king(cb.currentTurn()));
+	return search(cb.state(), limits);
+}
+
+Result Searcher::search(const State& root, const Limits& limits) {
+	s_limits = limits;
+	s_start = std::chrono::steady_clock::now();
+	s_stop = false;
+	s_table.newSearch();
+	for (auto& w : s_workers)
+		w->clear();
+
+	int maxDepth = std::min(limits.depth > 0 ? limits.depth : maxPly, maxPly - 1);
+	std::vector<std::thread> helpers;
+	for (std::size_t i = 1; i < s_workers.size(); i++)
+		helpers.emplace_back([this, &root, i]() {
+			s_workers[i]->iterate(root, maxPly - 1);
+		});
+
+	Result result = s_workers[0]->iterate(root, maxDepth);
+	s_stop = true;
+	for (auto& h : helpers)
+		h.join();
+
+	result.nodes = nodes();
+	result.time = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - s_start
+	);
+	return result;
+}
+
+bool Searcher::stopped() const {
+	if (s_limits.nodes and nodes() >= s_limits.nodes)
+		return true;
+	return s_limits.time.count() and
+		std::chrono::steady_clock::now() - s_start >= s_limits.time;
+}
+
+std::uint64_t Searcher::nodes() const {
+	std::uint64_t n = 0;
+	for (auto& w : s_workers)
+		n += w->nodes();
+	return n;
+}
+
+void Searcher::Worker::clear() {
+	w_nodes.store(0, std::memory_order_relaxed);
+	for (auto& k : w_killers)
+		k[0] = k[1] = Move();
+	for (auto& c : w_history)
+		for (auto& f : c)
+			std::fill(std::begin(f), std::end(f), 0);
+}
+
+Result Searcher::Worker::iterate(const State& root, int maxDepth) {
+	Result result;
+	int score = 0;
+	// helper threads are staggered by one ply
+	for (int depth = 1 + static_cast<int>(w_id & 1); depth <= maxDepth; depth++) {
+		int window = 25;
+		int alpha = -infinity, beta = infinity;
+		if (depth >= 5) {
+			alpha = std::max(score - window, -infinity);
+			beta = std::min(score + window, infinity);
+		}
+
+		while (true) {
+			score = pvs(root, depth, alpha, beta, 0, false);
+			if (w_searcher.s_stop)
+				break;
+			if (score <= alpha) {
+				beta = (alpha + beta)/2;
+				alpha = std::max(score - window, -infinity);
+			} else if (score >= beta) {
+				beta = std::min(score + window, infinity);
+			} else {
+				break;
+			}
+			window *= 2;
+		}
+
+		if (w_searcher.s_stop and result.depth > 0)
+			break;
+
+		result.score = score;
+		result.depth = depth;
+		result.pv.assign(w_pv[0], w_pv[0] + w_pvLength[0]);
+		result.bestMove = result.pv.empty() ? Move() : result.pv.front();
+
+		if (w_searcher.s_stop or result.pv.empty() or
+			std::abs(score) >= mateBound)
+			break;
+	}
+	return result;
+}
+
+bool Searcher::Worker::stopped() {
+	if (w_searcher.s_stop)
+		return true;
+	if (w_id == 0 and (nodes() & 1023) == 0 and w_searcher.stopped())
+		w_searcher.s_stop = true;
+	return w_searcher.s_stop;
+}
+
+int Searcher::Worker::pvs(const State& s, int depth, int alpha, int beta, int ply, bool nullMove) {
+	w_pvLength[ply] = 0;
+	if (depth <= 0)
+		return quiescence(s, alpha, beta, ply);
+
+	count();
+	if (ply > 0 and stopped())
+		return 0;
+
+	w_path[ply] = s.hash();
+	if (ply > 0) {
+		for (int p = ply - 2; p >= 0; p -= 2)
+			if (w_path[p] == s.hash())
+				return 0;
+	}
+	if (ply >= maxPly)
+		return evaluate(s);
+
+	bool pvNode = beta - alpha > 1;
+	TT::Entry entry;
+	Move ttMove;
+	if (w_searcher.s_table.probe(s.hash(), entry)) {
+		ttMove = entry.move;
+		int score = fromTable(entry.score, ply);
+		if (!pvNode and ply > 0 and entry.depth >= depth and (
+			entry.bound == TT::ExactBound or
+			(entry.bound == TT::LowerBound and score >= beta) or
+			(entry.bound == TT::UpperBound and score <= alpha)))
+			return score;
+	}
+
+	bool check = inCheck(s);
+	if (check)
+		depth++;
+
+	Piece::Color side = s.side();
+	Bitboard officers = s.occupancy(side) &
+		~s.pieces(side, PieceType::Pawn) & ~s.pieces(side, PieceType::King);
+	if (nullMove and !pvNode and !check and depth >= 3 and officers and
+		evaluate(s) >= beta) {
+		State null = s;
+		null.setEnPassant(-1);
+		null.setSide(enemy(side));
+		int r = 2 + depth/6;
+		int score = -pvs(null, depth - 1 - r, -beta, -beta + 1, ply + 1, false);
+		if (w_searcher.s_stop)
+			return 0;
+		if (score >= beta)
+			return score >= mateBound ? beta : score;
+	}
+
+	MoveList list;
+	s.generateLegal(list);
+	if (list.empty())
+		return check ? -mateScore + ply : 0;
+	order(s, list, ttMove, ply);
+
+	int best = -infinity, origin = alpha;
+	Move bestMove;
+	for (std::size_t i = 0; i < list.size(); i++) {
+		Move m = list[i];
+		State next = s;
+		next.makeMove(m);
+
+		bool quiet = !m.capture() and !m.promotion();
+		int score;
+		if (i == 0) {
+			score = -pvs(next, depth - 1, -beta, -alpha, ply + 1, true);
+		} else {
+			int r = (quiet and !check and !inCheck(next)) ?
+				reduction(depth, static_cast<int>(i)) : 0;
+			score = -pvs(next, depth - 1 - r, -alpha - 1, -alpha, ply + 1, true);
+			if (score > alpha and r)
+				score = -pvs(next, depth - 1, -alpha - 1, -alpha, ply + 1, true);
+			if (score > alpha and score < beta)
+				score = -pvs(next, depth - 1, -beta, -alpha, ply + 1, true);
+		}
+		if (w_searcher.s_stop)
+			return 0;
+
+		if (score > best) {
+			best = score;
+			bestMove = m;
+			if (score > alpha) {
+				alpha = score;
+				w_pv[ply][0] = m;
+				std::copy(w_pv[ply + 1], w_pv[ply + 1] + w_pvLength[ply + 1], w_pv[ply] + 1);
+				w_pvLength[ply] = w_pvLength[ply + 1] + 1;
+			}
+		}
+		if (alpha >= beta) {
+			if (quiet) {
+				if (w_killers[ply][0] != m) {
+					w_killers[ply][1] = w_killers[ply][0];
+					w_killers[ply][0] = m;
+				}
+				w_history[State::index(side)][m.from()][m.to()] += depth*depth;
+			}
+			break;
+		}
+	}
+
+	TT::Bound bound = best >= beta ? TT::LowerBound :
+		best > origin ? TT::ExactBound : TT::UpperBound;
+	w_searcher.s_table.store(s.hash(), {
+		bestMove, static_cast<std::int16_t>(toTable(best, ply)),
+		static_cast<std::int8_t>(depth), bound
+	});
+
+	return best;
+}
+
+int Searcher::Worker::quiescence(const State& s, int alpha, int beta, int ply) {
+	count();
+	w_pvLength[ply] = 0;
+	if (stopped())
+		return 0;
+
+	bool check = inCheck(s);
+	if (ply >= maxPly)
+		return check ? 0 : evaluate(s);
+
+	int best = -infinity;
+	if (!check) {
+		best = evaluate(s);
+		if (best >= beta)
+			return best;
+		alpha = std::max(alpha, best);
+	}
+
+	MoveList list;
+	s.generateLegal(list);
+	if (list.empty())
+		return check ? -mateScore + ply : 0;
+	order(s, list, Move(), ply);
+
+	for (Move m : list) {
+		if (!check and !m.capture() and !m.promotion())
+			continue;
+
+		State next = s;
+		next.makeMove(m);
+		int score = -quiescence(next, -beta, -alpha, ply + 1);
+		if (w_searcher.s_stop)
+			return 0;
+
+		if (score > best) {
+			best = score;
+			if (score > alpha) {
+				alpha = score;
+				if (score >= beta)
+					break;
+			}
+		}
+	}
+
+	return best;
+}
+
+void Searcher::Worker::order(const State& s, MoveList& list, Move best, int ply) const {
+	int scores[MoveList::capacity];
+	int side = State::index(s.side());
+	for (std::size_t i = 0; i < list.size(); i++) {
+		Move m = list[i];
+		int score;
+		if (m == best) {
+			score = 1 << 30;
+		} else if (m.capture() or m.promotion()) {
+			int victim = m.enPassant() ? values[0] :
+				m.capture() ? values[static_cast<int>(s.type(m.to()))] : 0;
+			if (m.promotion())
+				victim += values[static_cast<int>(m.promoteTo())];
+			score = (1 << 28) + victim*16 - values[static_cast<int>(s.type(m.from()))]/16;
+		} else if (m == w_killers[ply][0]) {
+			score = (1 << 27);
+		} else if (m == w_killers[ply][1]) {
+			score = (1 << 27) - 1;
+		} else {
+			score = std::min(w_history[side][m.from()][m.to()], (1 << 26));
+		}
+		scores[i] = score;
+	}
+
+	// insertion sort, lists are short
+	for (std::size_t i = 1; i < list.size(); i++) {
+		Move m = list[i];
+		int score = scores[i];
+		std::size_t j = i;
+		for ( ; j > 0 and scores[j - 1] < score; j--) {
+			list[j] = list[j - 1];
+			scores[j] = scores[j - 1];
+		}
+		list[j] = m;
+		scores[j] = score;
+	}
+}
+
+}
@@ -0,0 +1,69 @@
+#include <tartan/board/attacks.hpp>
+
+#include <iostream>
+
+tt::Bitboard reference(int sq, tt::Bitboard occupancy, const int (*dirs)[2]) {
+	using namespace tt;
+	Bitboard attacks = 0;
+	for (int i = 0; i < 4; i++) {
+		int x = squareX(sq) + dirs[i][0], y = squareY(sq) + dirs[i][1];
+		for ( ; x >= 1 and x <= 8 and y >= 1 and y <= 8; x += dirs[i][0], y += dirs[i][1]) {
+			attacks |= bit(square(x, y));
+			if (occupancy & bit(square(x, y)))
+				break;
+		}
+	}
+	return attacks;
+}
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace std;
+
+	const int bishop[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+	const int rook[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+	std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+	int failures = 0;
+	for (int i = 0; i < 2000; i++) {
+		seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+		Bitboard occupancy = seed & (seed >> 3);
+		for (int sq = 0; sq < 64; sq++) {
+			if (bishopAttacks(sq, occupancy) != reference(sq, occupancy, bishop))
+				failures++;
+			if (rookAttacks(sq, occupancy) != reference(sq, occupancy, rook))
+				failures++;
+			if (queenAttacks(sq, occupancy) != 
+				(reference(sq, occupancy, rook) | reference(sq, occupancy, bishop)))
+				failures++;
+		}
+	}
+
+	static_assert(ray(NorthEast, square(7, 7)) == bit(square(8, 8)),
+		"rays are built at compile time");
+	bool rays = 
+		ray(North, square(4, 4)) == 0x0808080800000000ULL and
+		ray(SouthWest, square(4, 4)) == 0x0000000000040201ULL and
+		ray(East, square(8, 1)) == 0;
+
+	static_assert(knightAttacks(square(1, 1)) == (bit(square(2, 3)) | bit(square(3, 2))),
+		"leaper tables are built at compile time");
+	bool steps = 
+		knightSteps.count[square(1, 1)] == 2 and
+		knightSteps.to[square(1, 1)][0] == Square(2, 3) and
+		kingSteps.count[square(4, 4)] == 8 and
+		pawnSteps[0].count[square(1, 7)] == 1;
+
+	bool leapers = steps and
+		knightAttacks(square(1, 1)) == (bit(square(2, 3)) | bit(square(3, 2))) and
+		popcount(knightAttacks(square(4, 4))) == 8 and
+		kingAttacks(square(8, 8)) == (bit(square(7, 8)) | bit(square(7, 7)) | bit(square(8, 7))) and
+		pawnAttacks(Piece::Color::White, square(1, 2)) == bit(square(2, 3)) and
+		pawnAttacks(Piece::Color::Black, square(5, 7)) == (bit(square(4, 6)) | bit(square(6, 6)));
+
+	cout << "attack mismatches: " << failures << endl;
+	cout << "rays: " << rays << endl;
+	cout << "leapers: " << leapers << endl;
+
+	return !(failures == 0 and rays and leapers);
+}
@@ -0,0 +1,112 @@
+#include <tartan/chess.hpp>
+#include "testutils.hpp"
+
+#include <iostream>
+
+bool consistent(const tt::chess::Chessboard& cb) {
+	using namespace tt;
+	using namespace tt::chess;
+
+	for (int sq = 0; sq < 64; sq++) {
+		const Piece* p = cb.at({squareX(sq), squareY(sq)});
+		bool occupied = cb.state().occupancy() & bit(sq);
+		if ((p != nullptr) != occupied)
+			return false;
+		if (p and (p->color() != cb.state().color(sq) or
+			!(cb.occupancy(p->color()) & bit(sq))))
+			return false;
+	}
+	return cb.occupancy() == cb.state().occupancy();
+}
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using Position = tt::Piece::Position;
+	using namespace std;
+
+	Chessboard cb;
+	cb.setPieceGetter(getQueen);
+	cb.fill();
+
+	const State& s = cb.state();
+	bool start =
+		s.pieces(C::White, PieceType::Pawn) == 0x000000000000FF00ULL and
+		s.pieces(C::Black, PieceType::Pawn) == 0x00FF000000000000ULL and
+		s.pieces(PieceType::Rook) == 0x8100000000000081ULL and
+		s.pieces(C::White, PieceType::King) == bit(square(5, 1)) and
+		s.pieces(C::Black, PieceType::Queen) == bit(square(4, 8)) and
+		s.occupancy(C::White) == 0xFFFFULL and
+		s.occupancy() == 0xFFFF00000000FFFFULL and
+		s.type(square(2, 1)) == PieceType::Knight;
+
+	cout << "start position bitboards: " << start << endl;
+
+	std::list<std::pair<Position, Position>> turns = {
+		{"e2", "e4"},
+		{"d7", "d5"},
+		{"e4", "d5"},
+		{"g8", "f6"},
+		{"g1", "f3"},
+		{"f6", "d5"},
+		{"f1", "c4"},
+		{"c7", "c5"},
+		{"e1", "g1"},
+		{"b7", "b5"},
+		{"c4", "b3"},
+		{"c5", "c4"},
+	};
+
+	try {
+		play(cb, turns, true);
+	} catch (exception& ex) {
+		cout << endl << "Error: " << ex.what();
+		return 1;
+	}
+
+	Chessboard target;
+	target.fill(
+		"ra8 kb8 bc8 qd8 xe8 bf8 rh8 "
+		"pa7 pe7 pf7 pg7 ph7 "
+		"pb5 kd5 "
+		"pc4 "
+		"Bb3 Kf3 "
+		"Pa2 Pb2 Pc2 Pd2 Pf2 Pg2 Ph2 "
+		"Ra1 Kb1 Bc1 Qd1 Rf1 Xg1 "
+	);
+
+	bool played =
+		consistent(cb) and
+		s == target.state() and
+		s.pieces(C::White, PieceType::Pawn) == 0x000000000000EF00ULL and
+		s.pieces(C::White, PieceType::Rook) == (bit(square(1, 1)) | bit(square(6, 1))) and
+		s.type(square(3, 4)) == PieceType::Pawn and
+		s.color(square(3, 4)) == C::Black;
+
+	cout << "played position bitboards: " << played << endl;
+
+	Chessboard promotion;
+	promotion.setPieceGetter(getQueen);
+	placeKings(promotion);
+	promotion.insertPiece(new Pawn("b6", C::White));
+	promotion.insertPiece(new Rook("a8", C::Black));
+	try {
+		play(promotion, {{"b6", "b7"}, {"e8", "e7"}, {"b7", "a8"}}, true);
+	} catch (exception& ex) {
+		cout << endl << "Error: " << ex.what();
+		return 1;
+	}
+	bool promoted =
+		consistent(promotion) and
+		promotion.state().pieces(C::White, PieceType::Queen) == bit(square(1, 8)) and
+		promotion.state().pieces(PieceType::Pawn) == 0 and
+		promotion.state().pieces(C::Black, PieceType::Rook) == 0;
+
+	cout << "promotion bitboards: " << promoted << endl;
+
+	cb.clear();
+	bool cleared = cb.state().occupancy() == 0 and cb.occupancy() == 0;
+
+	return !(start and played and promoted and cleared);
+}
@@ -0,0 +1,52 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	Chessboard cb;
+	cb.fill();
+	cb.makeTurn("e2", "e4");
+	cb.makeTurn("d7", "d5");
+	cb.makeTurn("e4", "d5");
+	cb.makeTurn("c7", "c5");
+
+	auto copy = cb.clone();
+	bool same = 
+		copy->state() == cb.state() and copy->hash() == cb.hash() and
+		copy->currentTurn() == C::White and 
+		copy->turnIndex() == cb.turnIndex() and copy->history().empty();
+	cout << "position: " << same << endl;
+
+	// en passant is still possible in the copy
+	bool passant = copy->perft(1) == cb.perft(1);
+	copy->makeTurn("d5", "c6");
+	bool independent = 
+		copy->hash() != cb.hash() and cb.at("d5") and
+		cb.at("d5")->board() == &cb and copy->at("c6")->board() == copy.get();
+	cout << "independence: " << passant << ' ' << independent << endl;
+
+	auto full = cb.clone(true);
+	bool history = 
+		full->history().size() == 4 and 
+		full->history().back()->piece() == full->at("c5") and
+		full->history().front()->piece() == full->at("d5");
+	cout << "history: " << history << endl;
+
+	Chessboard rooks;
+	rooks.fill("ra8 xe8 rh8 Ra1 Xe1 Rh1");
+	rooks.makeTurn("h1", "h2");
+	rooks.makeTurn("a8", "a7");
+	rooks.makeTurn("h2", "h1");
+	auto castling = rooks.clone();
+	bool rights = 
+		castling->state().castling() == (State::WhiteQueenside | State::BlackKingside) and
+		castling->perft(3) == rooks.perft(3);
+	cout << "castling rights: " << rights << endl;
+
+	return !(same and passant and independent and history and rights);
+}
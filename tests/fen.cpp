@@ -0,0 +1,137 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/exceptions.hpp>
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+std::uint64_t perft(const tt::chess::State& s, int depth) {
+	tt::chess::MoveList list;
+	s.generateLegal(list);
+	if (depth == 1)
+		return list.size();
+	std::uint64_t n = 0;
+	for (tt::chess::Move m : list) {
+		tt::chess::State next = s;
+		next.makeMove(m);
+		n += perft(next, depth - 1);
+	}
+	return n;
+}
+
+}
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	const char* start = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+	char buf[Chessboard::fenSize];
+
+	Chessboard filled;
+	filled.fill();
+	filled.toFEN(buf);
+	Chessboard loaded;
+	loaded.fromFEN(start);
+	bool startpos = string(buf) == start and loaded == filled and
+		loaded.hash() == filled.hash() and loaded.perft(3) == 8902;
+	cout << "start position: " << startpos << endl;
+
+	// Piece::moveMap() of loaded pieces must follow the State rules
+	const char* positions[] = {
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+		"rnbqkbnr/pp1ppppp/8/8/2pPP3/8/PPP2PPP/RNBQKBNR b Kq d3 0 3",
+		"4k3/8/8/8/8/8/8/4K2R w K - 12 40",
+	};
+	bool rules = true;
+	for (const char* fen : positions) {
+		Chessboard cb;
+		cb.fromFEN(fen);
+		cb.toFEN(buf);
+		std::uint64_t n = cb.perft(3), target = perft(cb.state(), 3);
+		if (string(buf) != fen or n != target) {
+			cout << fen << endl << buf << endl << n << " != " << target << endl;
+			rules = false;
+		}
+	}
+	cout << "rules: " << rules << endl;
+
+	bool clocks = true;
+	{
+		Chessboard cb;
+		cb.fromFEN("4k3/8/8/8/3p4/8/4P3/4K3 b - - 7 20");
+		cb.makeTurn("e8", "d8");
+		cb.makeTurn("e2", "e4");
+		cb.toFEN(buf);
+		clocks = clocks and string(buf) == "3k4/8/8/8/3pP3/8/8/4K3 b - e3 0 21";
+		auto copy = cb.clone();
+		copy->toFEN(buf);
+		clocks = clocks and string(buf) == "3k4/8/8/8/3pP3/8/8/4K3 b - e3 0 21";
+		cb.undoTurn();
+		cb.toFEN(buf);
+		clocks = clocks and string(buf) == "3k4/8/8/8/3p4/8/4P3/4K3 w - - 8 21";
+		// no pawn can capture en passant, so the tile is dropped
+		cb.fromFEN("3k4/8/8/8/4P3/8/8/4K3 b - e3 0 21");
+		cb.toFEN(buf);
+		clocks = clocks and string(buf) == "3k4/8/8/8/4P3/8/8/4K3 b - - 0 21";
+		cb.fromFEN("4k3/8/8/8/8/8/8/4K3 w - -");
+		clocks = clocks and cb.halfmoveClock() == 0 and cb.fullmoveNumber() == 1;
+	}
+	cout << "clocks: " << clocks << endl;
+
+	const char* invalid[] = {
+		"",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/8 w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNRR w KQkq - 0 1",
+		"rnbqkbnr/ppppxppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"rnbq1bnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQ - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNP w - - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkqK - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/1NBQKBNR w KQkq - 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e6 0 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - -1 1",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 0",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0",
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 x",
+		"4k3/4R3/8/8/8/8/8/4K3 w - - 0 1",
+		"krQQQQQQ/rp5Q/Q6Q/Q6Q/Q6Q/Q6Q/Q6Q/QQQQQQQK w - - 0 1",
+		"4k3/8/8/8/8/P7/PPPPPPPP/4K3 w - - 0 1",
+		"4k3/8/8/8/8/8/PPPPPPPP/QQ2K3 w - - 0 1",
+	};
+	bool validation = true;
+	Chessboard kept;
+	kept.fill();
+	for (const char* fen : invalid) {
+		bool thrown = false;
+		try {
+			kept.fromFEN(fen);
+		} catch (tt::chess::ex::bad_fen& ex) {
+			thrown = true;
+		}
+		bool rejected = kept.tryFromFEN(fen) == Status::BadFen;
+		if (!thrown or !rejected or kept != filled) {
+			cout << "accepted: \"" << fen << '"' << endl;
+			validation = false;
+		}
+	}
+	// nine queens, position with most legal moves
+	MoveList most;
+	validation = validation and
+		kept.tryFromFEN("R6R/3Q4/1Q4Q1/4Q3/2Q4Q/Q4Q2/pp1Q4/kBNN1KB1 w - - 0 1") == Status::Ok;
+	kept.legalMoves(most);
+	validation = validation and most.size() == 218;
+	validation = validation and kept.tryFromFEN(start) == Status::Ok;
+	cout << "validation: " << validation << endl;
+
+	return !(startpos and rules and clocks and validation);
+}
@@ -0,0 +1,88 @@
+#include <tartan/chess/ingest.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const char* templates[] = {
+	"[Event \"Scholar's mate\"]\n\n"
+		"1. e4 e5 {main line} 2. Bc4 Nc6 (2...Nf6 3. d3) 3. Qh5 Nf6?? 4. Qxf7# 1-0\n\n",
+	"[Event \"Promotion\"]\n[FEN \"r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1\"]\n\n"
+		"1. bxa8=Q+ Ke7 2. O-O-O Rb8 3. Qxb8 *\n\n",
+	"[Event \"Illegal\"]\n\n1. e4 e5 2. Ke3 0-1\n\n",
+	"[Event \"Ambiguous\"]\n[FEN \"4k3/8/8/8/8/8/4K3/R6R w - - 0 1\"]\n\n1. Rd1 *\n\n",
+	"[Event \"Bad FEN\"]\n[FEN \"8/8/8/8/8/8/8/8 w - - 0 1\"]\n\n*\n\n",
+	"[Event \"No result\"]\n\n1. d4 d5 2. c4 e6 3. Nc3 Nf6\n\n",
+};
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	string input;
+	for (int i = 0; i < 600; i++)
+		input += templates[(i*7 + i/6) % 6];
+
+	struct Replayed {
+		size_t index;
+		Status status;
+		size_t plies;
+		string fen;
+		bool operator==(const Replayed& o) const {
+			return index == o.index and status == o.status and plies == o.plies and fen == o.fen;
+		}
+	};
+
+	vector<Replayed> expected;
+	{
+		Chessboard cb;
+		PGNReader reader(input);
+		reader.replayAll(cb, [&expected](const PGNGame&, Chessboard& board, PGNReplay r) {
+			char fen[Chessboard::fenSize];
+			board.toFEN(fen);
+			expected.push_back({expected.size(), r.status, r.plies, fen});
+		});
+	}
+	size_t valid = 0, plies = 0;
+	for (const Replayed& r : expected) {
+		valid += r.status == Status::Ok;
+		plies += r.plies;
+	}
+
+	bool ordered = expected.size() == 600;
+	for (auto [threads, batch, queue] : {
+		std::tuple<size_t, size_t, size_t>{1, 1, 1}, {4, 3, 2}, {8, 64, 0}, {3, 1000, 5}, {0, 0, 0}
+	}) {
+		PGNIngest ingest(threads, batch, queue);
+		vector<Replayed> got;
+		PGNIngest::Summary s = ingest.run(input, [&got](const PGNIngest::Report& r) {
+			got.push_back({r.index, r.replay.status, r.replay.plies, r.fen});
+		});
+		bool ok = got == expected and s.games == 600 and s.valid == valid and s.plies == plies;
+		cout << "  " << ingest.threads() << " threads, " << ingest.batchSize() << " games in batch, "
+			<< ingest.queueSize() << " batches: " << ok << endl;
+		ordered = ordered and ok;
+	}
+	cout << "ordered: " << ordered << endl;
+
+	bool stop = true;
+	{
+		PGNIngest ingest(4, 2, 3);
+		size_t reported = 0;
+		PGNIngest::Summary s = ingest.run(input, [&](const PGNIngest::Report& r) {
+			stop = stop and r.index == reported++;
+			if (r.index == 10)
+				ingest.stop();
+		});
+		stop = stop and s.games == 11 and reported == 11;
+		// stopped PGNIngest can be run again
+		s = ingest.run(input, [](const PGNIngest::Report&) {});
+		stop = stop and s.games == 600;
+		s = ingest.run("  \n", [](const PGNIngest::Report&) {});
+		stop = stop and s.games == 0;
+	}
+	cout << "stop: " << stop << endl;
+
+	return !(ordered and stop);
+}
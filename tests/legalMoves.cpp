@@ -0,0 +1,85 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/exceptions.hpp>
+
+#include <iostream>
+
+std::uint64_t count(const tt::chess::State& s, int depth) {
+	tt::chess::MoveList list;
+	s.generateLegal(list);
+	if (depth == 1)
+		return list.size();
+
+	std::uint64_t nodes = 0;
+	for (auto m : list) {
+		tt::chess::State next = s;
+		next.makeMove(m);
+		nodes += count(next, depth - 1);
+	}
+	return nodes;
+}
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	Chessboard start;
+	start.fill();
+
+	Chessboard kiwipete;
+	kiwipete.fill(
+		"ra8 xe8 rh8 pa7 pc7 pd7 qe7 pf7 bg7 ba6 kb6 pe6 kf6 pg6 pb4 ph3 "
+		"Pd5 Ke5 Pe4 Kc3 Qf3 Pa2 Pb2 Pc2 Bd2 Be2 Pf2 Pg2 Ph2 Ra1 Xe1 Rh1"
+	);
+
+	Chessboard endgame;
+	endgame.fill("pc7 pd6 Xa5 Pb5 rh5 Rb4 pf4 xh4 Pe2 Pg2");
+
+	std::list<std::uint64_t> result = {
+		count(start.state(), 4),
+		count(kiwipete.state(), 1),
+		count(kiwipete.state(), 3),
+		count(endgame.state(), 4),
+	};
+	std::list<std::uint64_t> target = {
+		197281, 48, 97862, 43238,
+	};
+
+	cout << "expected:" << endl;
+	for (auto x : target)
+		cout << x << ' ';
+	cout << endl << "got:" << endl;
+	for (auto x : result)
+		cout << x << ' ';
+	cout << endl;
+
+	// whole side call has to agree with the per-piece Turn path
+	auto perPiece = [](const Chessboard& cb) {
+		std::size_t n = 0;
+		for (const Piece* p : cb.pieces(cb.currentTurn()))
+			for (const Piece::Turn* t : cb.possibleMoves(p))
+				n += t->possible();
+		return n;
+	};
+	MoveList startMoves, kiwipeteMoves, blackMoves;
+	start.legalMoves(startMoves);
+	kiwipete.legalMoves(kiwipeteMoves);
+	start.legalMoves(blackMoves, Piece::Color::Black);
+	bool side = 
+		startMoves.size() == perPiece(start) and 
+		kiwipeteMoves.size() == perPiece(kiwipete) and
+		kiwipeteMoves.size() == 48 and blackMoves.size() == 20;
+	cout << "side moves: " << side << endl;
+
+	bool thrown = false;
+	try {
+		MoveList none;
+		Chessboard empty;
+		empty.legalMoves(none);
+	} catch (tt::chess::ex::no_king& ex) {
+		thrown = true;
+	}
+	cout << "no king: " << thrown << endl;
+
+	return !(result == target and side and thrown);
+}
@@ -0,0 +1,81 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	bool encoding = 
+		sizeof(Move) == 2 and !Move() and
+		Move(square(5, 2), square(5, 4), Move::DoublePush).str() == "e2e4" and
+		Move(square(5, 7), square(4, 8), Move::QueenPromotion | Move::Capture).str() == "e7d8q" and
+		Move(square(5, 7), square(4, 8), Move::KnightPromotion).promoteTo() == PieceType::Knight and
+		Move(square(5, 7), square(4, 8), Move::QueenPromotion | Move::Capture).capture() and
+		Move(square(5, 1), square(7, 1), Move::KingCastle).castling();
+	cout << "encoding: " << encoding << endl;
+
+	Chessboard cb;
+	cb.fill();
+	MoveList list;
+	cb.state().generate(list);
+
+	Piece::TurnMap turns = cb.turns(list);
+	bool adapted = turns.size() == list.size();
+	std::size_t i = 0;
+	for (auto t : turns) {
+		adapted = adapted and 
+			square(t->from().x(), t->from().y()) == list[i].from() and
+			square(t->to().x(), t->to().y()) == list[i].to();
+		i++;
+	}
+
+	State s = cb.state();
+	s.makeMove(Move(square(5, 2), square(5, 4), Move::DoublePush));
+	cb.makeTurn("e2", "e4");
+	bool start = list.size() == 20 and adapted and
+		s == cb.state() and s.enPassant() == -1 and
+		s.side() == C::Black and s.castling() == State::AnyCastling;
+	cout << "start position: " << list.size() << ' ' << adapted << ' ' << start << endl;
+
+	Chessboard castling;
+	castling.fill("ra8 xe8 rh8 Ra1 Xe1 Rh1");
+	list.clear();
+	castling.state().generate(list);
+	s = castling.state();
+	s.makeMove(Move(square(5, 1), square(7, 1), Move::KingCastle));
+	castling.makeTurn("e1", "g1");
+	bool castled = list.size() == 26 and
+		list.contains(Move(square(5, 1), square(3, 1), Move::QueenCastle)) and
+		list.contains(Move(square(1, 1), square(1, 8), Move::Capture)) and
+		s == castling.state() and 
+		s.castling() == (State::BlackKingside | State::BlackQueenside);
+	cout << "castling: " << list.size() << ' ' << castled << endl;
+
+	Chessboard promotion;
+	promotion.fill("xe8 rc8 Pb7 Xe1");
+	list.clear();
+	promotion.state().generate(list);
+	bool promoted = list.size() == 13 and 
+		list.contains(Move(square(2, 7), square(2, 8), Move::RookPromotion)) and
+		list.contains(Move(square(2, 7), square(3, 8), Move::BishopPromotion | Move::Capture));
+	cout << "promotion: " << list.size() << ' ' << promoted << endl;
+
+	Chessboard passant;
+	passant.fill("xe8 pd4 Pe2 Xe1");
+	passant.makeTurn("e2", "e4");
+	list.clear();
+	passant.state().generate(list);
+	Move ep(square(4, 4), square(5, 3), Move::EnPassant);
+	turns = passant.turns(list);
+	bool captured = false;
+	for (auto t : turns)
+		if (t->to() == Piece::Position("e3") and t->from() == Piece::Position("d4"))
+			captured = t->capture() == passant.at({"e4"});
+	bool enPassant = list.contains(ep) and captured;
+	cout << "en passant: " << enPassant << endl;
+
+	return !(encoding and start and castled and promoted and enPassant);
+}
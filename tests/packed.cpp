@@ -0,0 +1,92 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/packed.hpp>
+
+#include <iostream>
+#include <string>
+
+using namespace tt;
+using namespace tt::chess;
+
+// every move made on the PackedState has to match State::makeMove()
+bool walk(const State& s, unsigned halfmove, unsigned fullmove, int depth, std::size_t& count) {
+	PackedState packed(s, halfmove, fullmove);
+	if (packed.state() != s or packed.state().hash() != s.hash() or
+		packed.halfmoveClock() != halfmove or packed.fullmoveNumber() != fullmove)
+		return false;
+	if (depth == 0)
+		return true;
+
+	MoveList list;
+	packed.generateLegal(list);
+	for (Move m : list) {
+		State next = s;
+		next.makeMove(m);
+		unsigned nextHalfmove = s.type(m.from()) == PieceType::Pawn or m.capture() ? 0 : halfmove + 1;
+		unsigned nextFullmove = fullmove + (s.side() == Piece::Color::Black);
+		PackedState made = packed;
+		made.makeMove(m);
+		count++;
+		if (made != PackedState(next, nextHalfmove, nextFullmove) or
+			!walk(next, nextHalfmove, nextFullmove, depth - 1, count))
+			return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	Chessboard cb;
+	cb.fill();
+	PackedState start(cb.state());
+	bool tiles = 
+		start.type(square(5, 1)) == PieceType::King and 
+		start.color(square(5, 1)) == C::White and
+		start.type(square(4, 8)) == PieceType::Queen and 
+		start.color(square(4, 8)) == C::Black and
+		start.empty(square(5, 4)) and
+		start.at(square(1, 2)) == PackedState::code(C::White, PieceType::Pawn) and
+		start.castling() == State::AnyCastling and start.side() == C::White;
+	cout << "tiles: " << tiles << endl;
+
+	std::size_t count = 0;
+	bool moves = walk(cb.state(), 0, 1, 3, count);
+	Chessboard special;
+	special.fill("ra8 xe8 rh8 Pb7 pd4 Pe2 Ra1 Xe1 Rh1");
+	moves = moves and walk(special.state(), 4, 10, 3, count);
+	cout << "moves: " << moves << ' ' << count << endl;
+
+	PackedState empty;
+	bool cleared = empty.state() == State() and PackedState(State()) == empty;
+	cout << "empty: " << cleared << endl;
+
+	bool restored = true;
+	{
+		char buf[Chessboard::fenSize], copyBuf[Chessboard::fenSize];
+		Chessboard game;
+		game.fromFEN("r3k2r/8/8/8/3p4/8/4P3/R3K2R w Kq - 5 30");
+		game.makeTurn("e2", "e4");
+		PackedState packed = game.toPacked();
+		Chessboard copy;
+		copy.fromPacked(packed);
+		game.toFEN(buf);
+		copy.toFEN(copyBuf);
+		restored = string(buf) == copyBuf and 
+			string(buf) == "r3k2r/8/8/8/3pP3/8/8/R3K2R b Kq e3 0 30" and
+			copy.hash() == game.hash() and copy.toPacked() == packed;
+
+		// restored board plays on like the original one
+		copy.makeTurn("d4", "e3");
+		game.makeTurn("d4", "e3");
+		packed.makeMove(Move(square(4, 4), square(5, 3), Move::EnPassant));
+		copy.makeTurn("e1", "g1");
+		game.makeTurn("e1", "g1");
+		packed.makeMove(Move(square(5, 1), square(7, 1), Move::KingCastle));
+		restored = restored and copy.toPacked() == packed and game.toPacked() == packed and
+			packed.halfmoveClock() == 1 and packed.fullmoveNumber() == 31;
+	}
+	cout << "restored: " << restored << endl;
+
+	return !(tiles and moves and cleared and restored);
+}
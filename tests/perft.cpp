@@ -0,0 +1,55 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+#include <numeric>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	Chessboard cb;
+	cb.fill();
+
+	std::list<std::uint64_t> result = {
+		cb.perft(1),
+		cb.perft(2),
+		cb.perft(3),
+	};
+	std::list<std::uint64_t> target = {
+		20, 400, 8902,
+	};
+
+	Chessboard::PerftDivideT divide = cb.perftDivide(3);
+	result.push_back(divide.size());
+	result.push_back(std::accumulate(divide.begin(), divide.end(), std::uint64_t(0),
+		[](std::uint64_t s, const auto& d) { return s + d.second; }));
+	target.push_back(20);
+	target.push_back(8902);
+
+	Chessboard castling;
+	castling.fill("ra8 xe8 rh8 Ra1 Xe1 Rh1");
+	result.push_back(castling.perft(1));
+	result.push_back(castling.perft(2));
+	result.push_back(castling.perft(3));
+	result.push_back(castling.perft(3, 1));
+	target.push_back(26);
+	target.push_back(568);
+	target.push_back(13744);
+	target.push_back(13744);
+
+	cout << "expected:\n";
+	for (auto& n : target)
+		cout << n << ' ';
+	cout << "\ngot:\n";
+	for (auto& n : result)
+		cout << n << ' ';
+	cout << endl;
+
+	cout << "after perft:\n" << castling;
+
+	Chessboard untouched;
+	untouched.fill("ra8 xe8 rh8 Ra1 Xe1 Rh1");
+
+	return !(target == result and castling == untouched);
+}
@@ -0,0 +1,165 @@
+#include <tartan/chess/pgn.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const char* games = R"([Event "Scholar's mate"]
+[Site "?"]
+[White "A \"quoted\" name"]
+
+1.e4 {opening (not a variation} e5 (1...c5 2.Nf3 (2.c3 {alapin}) d6) $1
+2. Bc4 ; comment till the end of line 3. a3
+Nc6 3. Qh5 Nf6?? 4. Qxf7# 1-0
+
+[Event "Promotion and castling"]
+[SetUp "1"]
+[FEN "r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1"]
+
+1. bxa8=Q+ Ke7 2. O-O-O Rb8 3. Qxb8 *
+%escaped line 1. e4
+[Event "No result"]
+1. d4 d5
+[Event "Next"]
+1. Nf3 Nf6 2. g3 g6 3.Bb5 1/2-1/2
+[Event "Ambiguous"]
+[FEN "4k3/8/8/8/8/8/4K3/R6R w - - 0 1"]
+1. Rd1 *
+[Event "Illegal"]
+1. e4 e5 2. Ke3 0-1
+[Event "Malformed"
+1. e4 *
+[FEN "8/8/8/8/8/8/8/8 w - - 0 1"]
+1. e4 *
+)";
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	char buf[Chessboard::fenSize];
+	auto fen = [&buf](const Chessboard& cb) {
+		cb.toFEN(buf);
+		return string(buf);
+	};
+
+	bool tokens = true;
+	{
+		string_view movetext =
+			"1.e4 {c (x} e5 (1...c5 2.Nf3 (2.c3 {y}) d6) $1 2.Nf3!? ; x\n"
+			"2... Nc6 3. 0-0-0+ 3...e8=Q# 12.Ng1-f3 1-0 4. d4";
+		vector<string_view> sans;
+		for (string_view s = PGNReader::nextSAN(movetext); !s.empty(); s = PGNReader::nextSAN(movetext))
+			sans.push_back(s);
+		tokens = sans == vector<string_view>{"e4", "e5", "Nf3!?", "Nc6", "0-0-0+", "e8=Q#", "Ng1-f3"} and
+			movetext.empty();
+	}
+	cout << "tokens: " << tokens << endl;
+
+	bool san = true;
+	{
+		Chessboard cb;
+		Move m;
+		cb.fromFEN("r3k2r/1P1n4/8/3p4/4P3/1N3N2/8/R3K2R w KQkq - 0 1");
+		san = san and
+			cb.findSAN("exd5", m) == Status::Ok and m.str() == "e4d5" and
+			cb.findSAN("e5", m) == Status::Ok and m.str() == "e4e5" and
+			cb.findSAN("Nbd4", m) == Status::Ok and m.str() == "b3d4" and
+			cb.findSAN("Nfxd4", m) == Status::Ok and m.str() == "f3d4" and
+			cb.findSAN("Nd4", m) == Status::AmbiguousMove and !m and
+			cb.findSAN("bxa8=Q", m) == Status::Ok and m.str() == "b7a8q" and
+			cb.findSAN("bxa8N+", m) == Status::Ok and m.str() == "b7a8n" and
+			cb.findSAN("b8", m) == Status::NoSuchMove and
+			cb.findSAN("b8=K", m) == Status::BadSan and
+			cb.findSAN("O-O", m) == Status::Ok and m.str() == "e1g1" and
+			cb.findSAN("0-0-0", m) == Status::Ok and m.str() == "e1c1" and
+			cb.findSAN("Kg1", m) == Status::NoSuchMove and
+			cb.findSAN("R1a3", m) == Status::Ok and m.str() == "a1a3" and
+			cb.findSAN("Ra1-a3", m) == Status::Ok and m.str() == "a1a3" and
+			cb.findSAN("Nd9", m) == Status::BadSan and
+			cb.findSAN("Zd4", m) == Status::BadSan and
+			cb.findSAN("+", m) == Status::BadSan;
+	}
+	cout << "san: " << san << endl;
+
+	bool split = true;
+	{
+		PGNReader reader(games);
+		PGNGame game;
+		vector<PGNGame> read;
+		while (reader.next(game))
+			read.push_back(game);
+		split = read.size() == 8 and reader.offset() == string_view(games).size() and
+			!reader.next(game) and
+			read[0].tags.size() == 3 and read[0].tag("Event") == "Scholar's mate" and
+			read[0].tag("White") == "A \\\"quoted\\\" name" and read[0].tag("Round").empty() and
+			read[0].result == "1-0" and read[0].movetext.substr(0, 5) == "1.e4 " and
+			read[0].movetext.back() == '#' and
+			read[0].text.substr(0, 7) == "[Event " and read[0].text.back() == '0' and
+			read[1].result == "*" and
+			read[2].result.empty() and read[2].movetext == "1. d4 d5" and
+			read[3].tag("Event") == "Next" and read[3].result == "1/2-1/2" and
+			read[6].tags.empty() and read[6].movetext == "[Event \"Malformed\"\n1. e4";
+	}
+	cout << "split: " << split << endl;
+
+	bool replay = true;
+	{
+		struct Replayed {
+			Status status;
+			size_t plies;
+			string san, fen;
+		};
+		vector<Replayed> replayed;
+		Chessboard cb;
+		PGNReader reader(games);
+		size_t count = reader.replayAll(cb, [&](const PGNGame&, Chessboard& board, PGNReplay r) {
+			replayed.push_back({r.status, r.plies, string(r.san), fen(board)});
+		});
+		replay = count == 8 and
+			replayed[0].status == Status::Ok and replayed[0].plies == 7 and
+			replayed[0].fen == "r1bqkb1r/pppp1Qpp/2n2n2/4p3/2B1P3/8/PPPP1PPP/RNB1K1NR b KQkq - 0 4" and
+			replayed[1].status == Status::Ok and replayed[1].plies == 5 and
+			replayed[1].fen == "1Q6/4k3/8/8/8/8/8/2KR3R b - - 0 3" and
+			replayed[2].status == Status::Ok and replayed[2].plies == 2 and
+			replayed[3].status == Status::NoSuchMove and replayed[3].plies == 4 and
+			replayed[3].san == "Bb5" and
+			replayed[4].status == Status::AmbiguousMove and replayed[4].plies == 0 and
+			replayed[4].san == "Rd1" and
+			replayed[5].status == Status::NoSuchMove and replayed[5].plies == 2 and
+			replayed[5].san == "Ke3" and
+			replayed[5].fen == "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2" and
+			replayed[6].status == Status::BadSan and replayed[6].san == "[Event" and
+			replayed[7].status == Status::BadFen and replayed[7].san.empty();
+		for (const Replayed& r : replayed)
+			cout << "  " << what(r.status) << ", " << r.plies << " plies, " << r.fen << endl;
+	}
+	cout << "replay: " << replay << endl;
+
+	bool file = true;
+	{
+		const char* path = "pgnTest.pgn";
+		if (std::FILE* f = std::fopen(path, "wb")) {
+			std::fputs(games, f);
+			std::fclose(f);
+		}
+		{
+			MappedFile mapped(path);
+			Chessboard cb;
+			PGNReader reader(mapped.view());
+			size_t ok = 0;
+			reader.replayAll(cb, [&ok](const PGNGame&, Chessboard&, PGNReplay r) {
+				ok += r.status == Status::Ok;
+			});
+			file = mapped.isOpen() and mapped.view() == games and ok == 3;
+		}
+		std::remove(path);
+		MappedFile missing("pgnTestMissing.pgn");
+		file = file and !missing.isOpen() and missing.view().empty();
+	}
+	cout << "file: " << file << endl;
+
+	return !(tokens and san and split and replay and file);
+}
@@ -0,0 +1,60 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+#include <typeindex>
+
+// piece lists have to match the tiles
+bool consistent(const tt::Board& b) {
+	using C = tt::Piece::Color;
+	for (C c : {C::White, C::Black}) {
+		if (b.pieces(c).size() != static_cast<std::size_t>(tt::popcount(b.occupancy(c))))
+			return false;
+		for (const tt::Piece* p : b.pieces(c))
+			if (p->color() != c or b.at(p->position()) != p)
+				return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	Chessboard cb;
+	cb.fill();
+	bool filled = consistent(cb) and 
+		cb.pieces(C::White).size() == 16 and cb.pieces(C::Black).size() == 16;
+	cout << "filled: " << filled << endl;
+
+	cb.makeTurn("e2", "e4");
+	cb.makeTurn("d7", "d5");
+	cb.makeTurn("e4", "d5");
+	bool captured = consistent(cb) and cb.pieces(C::Black).size() == 15;
+	cb.undoTurn();
+	bool restored = consistent(cb) and cb.pieces(C::Black).size() == 16;
+	cout << "capture: " << captured << ' ' << restored << endl;
+
+	Chessboard promotion;
+	promotion.setPieceGetter([](Board::PieceTypesArgT) -> std::type_index {
+		return typeid(Queen);
+	});
+	promotion.fill("xh8 rc8 Pb7 Xa1");
+	promotion.makeTurn("b7", "c8");
+	bool promoted = consistent(promotion) and 
+		promotion.pieces(C::White).size() == 2 and
+		promotion.pieces(C::Black).size() == 1;
+	promotion.undoTurn();
+	promoted = promoted and consistent(promotion) and 
+		promotion.pieces(C::Black).size() == 2;
+	cout << "promotion: " << promoted << endl;
+
+	std::unique_ptr<Chessboard> copy = cb.clone();
+	bool cloned = consistent(*copy) and copy->pieces(C::White).size() == 16;
+	cb.clear();
+	bool cleared = cb.pieces(C::White).empty() and cb.pieces(C::Black).empty();
+	cout << "clone: " << cloned << " clear: " << cleared << endl;
+
+	return !(filled and captured and restored and promoted and cloned and cleared);
+}
@@ -0,0 +1,56 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+class Stone : public tt::Piece {
+public:
+	using Piece::Piece;
+	TurnMap moveMap(int) const override { return {}; };
+};
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	Chessboard cb;
+	cb.fill();
+	std::string letters;
+	for (int x = 1; x <= 8; x++) {
+		PieceType t;
+		if (pieceType(cb.at({x, 1}), t))
+			letters += "pnbrqk"[State::index(t)];
+	}
+	bool tags = letters == "rnbqkbnr";
+	cout << "tags: " << letters << endl;
+
+	const Piece* queen = cb.at("d1");
+	Piece* copy = visit(queen, [](const auto* q) -> Piece* {
+		return new std::decay_t<decltype(*q)>(*q);
+	});
+	bool visited = 
+		copy->type() == State::index(PieceType::Queen) and 
+		copy->position() == queen->position() and
+		visit(cb.at("e8"), [](auto* p) {
+			if constexpr (std::is_same_v<decltype(p), King*>)
+				return !p->castled();
+			else
+				return false;
+		});
+	delete copy;
+	cout << "visit: " << visited << endl;
+
+	Stone stone;
+	PieceType t;
+	bool foreign = stone.type() == -1 and !pieceType(&stone, t);
+	try {
+		visit(static_cast<Piece*>(&stone), [](auto*) { return 0; });
+		foreign = false;
+	} catch (tt::ex::bad_piece_type&) {
+	}
+	cout << "foreign piece: " << foreign << endl;
+
+	return !(tags and visited and foreign);
+}
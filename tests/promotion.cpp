@@ -0,0 +1,50 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+#include <typeindex>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	// engine State perft results of the same positions
+	Chessboard capture;
+	capture.fill("xh8 rc8 Pb7 pg2 Xa1");
+	Chessboard knights;
+	knights.fill("xh8 ka8 Pb7 Pd7 pe2 pc2 Kb1 Xg3");
+	std::uint64_t nodes[2] = {capture.perft(3), knights.perft(3)};
+	bool perft = nodes[0] == 1290 and nodes[1] == 5553;
+	cout << "perft: " << nodes[0] << ' ' << nodes[1] << endl;
+
+	std::size_t promotions = 0;
+	for (auto& d : capture.perftDivide(1))
+		promotions += d.first.size() == 5;
+	bool divide = promotions == 8;
+	cout << "divide promotions: " << promotions << endl;
+
+	Chessboard cb;
+	Board::PieceTypesArgT offered;
+	cb.setPieceGetter([&offered](Board::PieceTypesArgT types) -> std::type_index {
+		offered = types;
+		return typeid(Knight);
+	});
+	cb.fill("xh8 rc8 Pb7 Xa1");
+	const Piece* pawn = cb.at("b7");
+	cb.makeTurn("b7", "c8");
+	const Piece* knight = cb.at("c8");
+	bool selected = 
+		offered.size() == 4 and dynamic_cast<const Knight*>(knight) and
+		cb.state().type(square(3, 8)) == PieceType::Knight;
+	cout << "selected: " << selected << endl;
+
+	cb.undoTurn();
+	bool undone = 
+		cb.at("b7") == pawn and cb.at("c8") and
+		cb.state().type(square(2, 7)) == PieceType::Pawn;
+	cb.redoTurn();
+	bool reused = cb.at("c8") == knight;
+	cout << "undo: " << undone << ' ' << reused << endl;
+
+	return !(perft and divide and selected and undone and reused);
+}
@@ -0,0 +1,62 @@
+#include <tartan/chess.hpp>
+#include <tartan/search.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	search::Searcher searcher(4);
+
+	Chessboard backRank;
+	backRank.fill("xg8 pf7 pg7 ph7 Ra1 Xg1");
+	search::Result r = searcher.search(backRank, {6});
+	bool mate = 
+		r.bestMove == Move(square(1, 1), square(1, 8)) and
+		r.score == search::mateScore - 1 and
+		r.pv.size() == 1;
+	cout << "mate in one: " << r.bestMove.str() << ' ' << r.score << ' ' << mate << endl;
+
+	Chessboard hanging;
+	hanging.fill("xe8 ph7 qd5 Ph2 Xe1 Rd1");
+	r = searcher.search(hanging, {5});
+	bool capture = 
+		r.bestMove == Move(square(4, 1), square(4, 5), Move::Capture) and
+		r.score > 400 and r.depth == 5;
+	cout << "hanging queen: " << r.bestMove.str() << ' ' << r.score << ' ' << capture << endl;
+
+	Chessboard defended;
+	defended.fill("xa8 Qb7 Xc6");
+	defended.setCurrentTurn(C::Black);
+	r = searcher.search(defended, {4});
+	bool mated = !r.bestMove and r.score == -search::mateScore;
+	cout << "mated: " << mated << endl;
+
+	Chessboard start;
+	start.fill();
+	r = searcher.search(start, {64, 20000});
+	bool limited = 
+		r.bestMove and r.nodes >= 20000 and r.nodes < 40000 and 
+		!r.pv.empty() and r.pv.front() == r.bestMove;
+	cout << "node limit: " << r.nodes << ' ' << r.depth << ' ' << limited << endl;
+	for (auto m : r.pv)
+		cout << m.str() << ' ';
+	cout << endl;
+
+	search::Searcher parallel(4, 4);
+	r = parallel.search(hanging, {6});
+	bool smp = parallel.threads() == 4 and
+		r.bestMove == Move(square(4, 1), square(4, 5), Move::Capture) and
+		r.depth == 6;
+	r = parallel.search(backRank, {6});
+	smp = smp and r.bestMove == Move(square(1, 1), square(1, 8)) and
+		r.score == search::mateScore - 1;
+	r = parallel.search(start, {64, 100000});
+	smp = smp and r.bestMove and r.nodes >= 100000;
+	cout << "threads: " << r.nodes << ' ' << r.depth << ' ' << smp << endl;
+
+	return !(mate and capture and mated and limited and smp);
+}
@@ -0,0 +1,65 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/exceptions.hpp>
+
+#include <iostream>
+#include <typeindex>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	// random games made with makeTurn() have to follow State::makeMove()
+	std::uint64_t seed = 0x2545F4914F6CDD1DULL;
+	std::size_t plies = 0;
+	bool games = true;
+	for (int g = 0; g < 20 and games; g++) {
+		Chessboard cb;
+		cb.setPieceGetter([](Board::PieceTypesArgT) -> std::type_index {
+			return typeid(Rook);
+		});
+		cb.fill();
+		State s = cb.state();
+		for (int i = 0; i < 150; i++) {
+			MoveList list;
+			cb.legalMoves(list);
+			if (list.empty() or cb.halfmoveClock() >= 100)
+				break;
+			seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+			Move m = list[seed % list.size()];
+			if (m.promotion())
+				m = Move(m.from(), m.to(), Move::RookPromotion | (m.flags() & Move::Capture));
+
+			const Piece::Turn* t = cb.makeTurn(
+				{squareX(m.from()), squareY(m.from())}, 
+				{squareX(m.to()), squareY(m.to())}
+			);
+			s.makeMove(m);
+			plies++;
+			if (cb.state() != s or cb.hash() != s.hash() or t != cb.history().back()) {
+				cout << "mismatch at " << m.str() << endl << cb;
+				games = false;
+				break;
+			}
+		}
+	}
+	cout << "games: " << games << ' ' << plies << endl;
+
+	Chessboard pinned;
+	pinned.fill("xe8 re7 Ke2 Xe1");
+	bool check = false;
+	try {
+		pinned.makeTurn("e2", "c3");
+	} catch (tt::chess::ex::check& ex) {
+		check = true;
+	}
+	bool nosuch = false;
+	try {
+		pinned.makeTurn("e2", "e4");
+	} catch (tt::ex::no_such_move& ex) {
+		nosuch = true;
+	}
+	cout << "illegal: " << check << ' ' << nosuch << endl;
+
+	return !(games and check and nosuch);
+}
@@ -0,0 +1,37 @@
+#include <tartan/board.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using Position = tt::Piece::Position;
+	using tt::Square;
+	using namespace std;
+
+	static_assert(sizeof(Square) == 1, "Square must be one byte");
+	static_assert(Square(2, 3).index() == 17, "Square index");
+	static_assert(!Square(8, 1).tryOffset(1, 0), "Square off-board offset");
+	static_assert(*Square(1, 1).tryOffset(1, 2) == Square(2, 3), "Square offset");
+
+	bool convert = true;
+	for (int i = 0; i < 64; i++) {
+		Square sq(i);
+		convert = convert and Position(sq).square() == sq and
+			Position(sq) == Position(sq.x(), sq.y());
+	}
+	cout << "conversion: " << convert << endl;
+
+	Position e1("e1");
+	Position e8("e8");
+	e8.setMode(Position::Mode::Reverse);
+	bool offset = 
+		*e1.tryOffset(1, 1) == Position("f2") and
+		!e1.tryOffset(0, -1) and
+		*e8.tryOffset(1, 1) == Position("d7") and
+		e8.tryOffset(1, 1)->mode() == Position::Mode::Reverse and
+		!e8.tryOffset(0, -1) and
+		!Position("h4").tryOffset(1, 0) and
+		!Position("a4").tryOffset(-2, 1);
+	cout << "offset: " << offset << endl;
+
+	return !(convert and offset);
+}
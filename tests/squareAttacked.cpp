@@ -0,0 +1,34 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	Chessboard cb;
+	cb.fill("xe8 qa5 bh5 kf3 pd3 Xe1 Rd1 Ph2");
+
+	bool attacked = 
+		cb.isSquareAttacked({"e1"}, C::Black) and
+		cb.isSquareAttacked({"c2"}, C::White) == false and
+		!cb.isSquareAttacked({"d1"}, C::Black) and
+		cb.isSquareAttacked({"e2"}, C::Black) and
+		cb.isSquareAttacked({"d3"}, C::White) and
+		!cb.isSquareAttacked({"f1"}, C::Black) and
+		!cb.isSquareAttacked({"h8"}, C::White);
+
+	Bitboard attackers = cb.attackersOf({"e1"});
+	Bitboard expected = bit(square(6, 3)) | bit(square(1, 5)) | bit(square(4, 1));
+	bool found = attackers == expected;
+
+	bool kingCheck = cb.whiteKing()->check() and !cb.blackKing()->check();
+
+	cout << "attacked: " << attacked << endl;
+	cout << "attackers: " << found << endl;
+	cout << "check: " << kingCheck << endl;
+
+	return !(attacked and found and kingCheck);
+}
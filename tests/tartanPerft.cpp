@@ -0,0 +1,73 @@
+#include <tartan/chess.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	bool divide = false;
+	bool black = false;
+	size_t hash = 0;
+	int depth = -1;
+	string pieces;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-d") or !strcmp(argv[i], "--divide"))
+			divide = true;
+		else if (!strcmp(argv[i], "-b") or !strcmp(argv[i], "--black"))
+			black = true;
+		else if ((!strcmp(argv[i], "-H") or !strcmp(argv[i], "--hash")) and i + 1 < argc)
+			hash = stoul(argv[++i]);
+		else if (depth < 0)
+			depth = stoi(argv[i]);
+		else
+			pieces.append(argv[i]).push_back(' ');
+	}
+
+	if (depth < 0) {
+		cerr << "usage: " << argv[0] 
+			<< " [-d|--divide] [-b|--black] [-H|--hash MiB] depth [piece specs...]\n"
+			<< "Counts leaf nodes of legal move tree of the default or "
+			<< "given (eq. \"Xe1 Ra1 xe8\") position.\n";
+		return 1;
+	}
+
+	Chessboard cb;
+	try {
+		if (pieces.empty())
+			cb.fill();
+		else
+			cb.fill(pieces);
+		if (black)
+			cb.setCurrentTurn(Piece::Color::Black);
+	} catch (exception& ex) {
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	cout << cb;
+
+	auto start = chrono::steady_clock::now();
+	uint64_t nodes = 0;
+	if (divide) {
+		for (auto& d : cb.perftDivide(depth, hash)) {
+			cout << d.first << ": " << d.second << '\n';
+			nodes += d.second;
+		}
+	} else {
+		nodes = cb.perft(depth, hash);
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	cout << "Depth: " << depth << '\n'
+		<< "Nodes: " << nodes << '\n'
+		<< "Time: " << elapsed.count() << " s\n"
+		<< "Speed: " << uint64_t(nodes / max(elapsed.count(), 1e-9)) << " nodes/s" << endl;
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include <tartan/chess.hpp>
+#include <tartan/chess/transposition.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+	using TT = TranspositionTable;
+
+	TT table(1);
+	TT::Entry e;
+	Move best(square(5, 2), square(5, 4), Move::DoublePush);
+	table.store(0x1234567890ABCDEFULL, {best, -250, 7, TT::LowerBound});
+	bool stored = 
+		table.size() == (1 << 20)/16 and
+		table.probe(0x1234567890ABCDEFULL, e) and 
+		e.move == best and e.score == -250 and e.depth == 7 and 
+		e.bound == TT::LowerBound and
+		!table.probe(0x1234567890ABCDEEULL, e);
+	cout << "stored: " << stored << endl;
+
+	table.store(0x1234567890ABCDEFULL, {Move(), 10, 8, TT::ExactBound});
+	bool kept = table.probe(0x1234567890ABCDEFULL, e) and 
+		e.move == best and e.score == 10 and e.depth == 8;
+	table.store(0x1234567890ABCDEFULL, {Move(), 11, 2, TT::UpperBound});
+	kept = kept and table.probe(0x1234567890ABCDEFULL, e) and e.depth == 8;
+	cout << "replacement: " << kept << endl;
+
+	// every thread writes entries whose data is derived from the key,
+	// so a torn slot would show up as a mismatch
+	table.clear();
+	std::vector<std::thread> threads;
+	std::vector<int> mismatches(4, 0);
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([&table, &mismatches, t]() {
+			std::uint64_t seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+			for (int i = 0; i < 200000; i++) {
+				seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+				std::uint64_t key = seed & 0xFFFFFFFFFFFFF;
+				TT::Entry e;
+				if (table.probe(key, e) and 
+					(e.score != static_cast<std::int16_t>(key >> 20) or 
+					e.depth != static_cast<std::int8_t>(key & 63)))
+					mismatches[t]++;
+				table.store(key, {
+					Move(), static_cast<std::int16_t>(key >> 20),
+					static_cast<std::int8_t>(key & 63), TT::ExactBound
+				});
+			}
+		});
+	}
+	for (auto& t : threads)
+		t.join();
+	int torn = mismatches[0] + mismatches[1] + mismatches[2] + mismatches[3];
+	cout << "concurrent mismatches: " << torn << endl;
+	cout << "hashfull: " << table.hashfull() << endl;
+
+	return !(stored and kept and torn == 0);
+}
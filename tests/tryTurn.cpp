@@ -0,0 +1,112 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+#include <typeindex>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+	using Position = Piece::Position;
+
+	bool position =
+		*Position::tryPosition(3, 4) == Position("c4") and
+		*Position::tryPosition("H8") == Position("h8") and
+		!Position::tryPosition(0, 4) and
+		!Position::tryPosition(3, 9) and
+		!Position::tryPosition("i1") and
+		!Position::tryPosition("a0") and
+		!Position::tryPosition("a10");
+	cout << "position: " << position << endl;
+
+	bool fill = true;
+	{
+		Chessboard cb;
+		fill = fill and cb.tryFill("Xe1 xe8 Pz9") == Status::BadPieceSpec and
+			cb.tryFill("Xe1 xe8 Pe") == Status::BadPieceSpec and
+			cb.tryFill("Xe1 xe8 ye2") == Status::BadPieceSpec and
+			cb.occupancy() == 0;
+		fill = fill and cb.tryFill("Xe1 xe8 Pe2") == Status::Ok and
+			popcount(cb.occupancy()) == 3;
+		fill = fill and cb.tryFill("Xd1") == Status::DuplicateKing and
+			cb.tryFill("Pe2") == Status::PositionIsTaken and
+			popcount(cb.occupancy()) == 3;
+		Piece* p = cb.piece("Pa2");
+		fill = fill and cb.tryInsertPiece(p) == Status::Ok and cb.at("a2") == p;
+	}
+	{
+		// extra queen of the side with 8 pawns is not promoted from anything
+		Chessboard cb;
+		fill = fill and cb.tryFill("Xe1 xe8 Qd1 Pa2 Pb2 Pc2 Pd2 Pe2 Pf2 Pg2 Ph2") == Status::Ok and
+			cb.tryFill("Qd4") == Status::TooManyPieces and
+			cb.tryFill("qd5 qd4") == Status::Ok and
+			popcount(cb.occupancy()) == 13;
+	}
+	cout << "fill: " << fill << endl;
+
+	// rejected moves must leave the board as it was
+	auto rejected = [](Chessboard& cb, const Position& from, const Position& to, Status s) {
+		std::uint64_t hash = cb.hash();
+		std::size_t moves = cb.movesMade();
+		const Piece::Turn* t = nullptr;
+		return cb.tryMakeTurn(from, to, &t) == s and
+			t == nullptr and cb.hash() == hash and cb.movesMade() == moves;
+	};
+
+	bool moves = true;
+	{
+		Chessboard cb;
+		cb.fill();
+		moves = moves and
+			rejected(cb, "e4", "e5", Status::TileIsEmpty) and
+			rejected(cb, "e7", "e5", Status::PieceInWrongColor) and
+			rejected(cb, "a1", "a3", Status::CanNotMove) and
+			rejected(cb, "b1", "b3", Status::NoSuchMove) and
+			rejected(cb, "e2", "e5", Status::NoSuchMove);
+		const Piece::Turn* t = nullptr;
+		moves = moves and cb.tryMakeTurn("e2", "e4", &t) == Status::Ok and
+			t == cb.history().back() and cb.currentTurn() == Piece::Color::Black and
+			cb.tryMakeTurn("e7", "e5") == Status::Ok;
+	}
+	{
+		Chessboard cb;
+		cb.fill({"Xe1", "Ra1", "re8", "xa8"});
+		moves = moves and rejected(cb, "a1", "a2", Status::Check);
+	}
+	{
+		Chessboard cb;
+		cb.fill({"Xh1", "Ph2", "Pg2", "re1", "xa8"});
+		moves = moves and rejected(cb, "g2", "g3", Status::Checkmate);
+	}
+	{
+		Chessboard cb;
+		cb.fill({"Pe2", "xe8"});
+		moves = moves and rejected(cb, "e2", "e4", Status::NoKing);
+	}
+	{
+		Chessboard cb;
+		cb.fill({"Xa1", "Pb7", "xh8"});
+		moves = moves and rejected(cb, "b7", "b8", Status::NoPieceGetter);
+		cb.setPieceGetter([](Board::PieceTypesArgT) -> std::type_index {
+			return typeid(King);
+		});
+		moves = moves and rejected(cb, "b7", "b8", Status::BadPieceType);
+		cb.setPieceGetter([](Board::PieceTypesArgT) -> std::type_index {
+			return typeid(nullptr);
+		});
+		moves = moves and rejected(cb, "b7", "b8", Status::BadPieceType);
+		cb.setPieceGetter([](Board::PieceTypesArgT) -> std::type_index {
+			return typeid(Knight);
+		});
+		moves = moves and cb.tryMakeTurn("b7", "b8") == Status::Ok and
+			cb.at("b8")->type() == State::index(PieceType::Knight);
+	}
+	cout << "moves: " << moves << endl;
+
+	bool what =
+		std::string(tt::what(Status::Check)) == "King is under check after move" and
+		std::string(tt::what(Status::NoSuchMove)) == "Selected piece can't perform such move";
+	cout << "what: " << what << endl;
+
+	return !(position and fill and moves and what);
+}
@@ -0,0 +1,70 @@
+#include <tartan/chess.hpp>
+#include "testutils.hpp"
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using namespace std;
+
+	const char* position = "xe8 ra8 pd4 Pb6 Pe2 Xe1 Rh1";
+	Chessboard start;
+	start.fill(position);
+
+	Chessboard cb;
+	cb.setPieceGetter(getQueen);
+	cb.fill(position);
+	Chessboard::TurnsT turns = {
+		{"e2", "e4"}, // double push
+		{"d4", "e3"}, // en passant
+		{"e1", "g1"}, // castling
+		{"e8", "d7"},
+		{"b6", "b7"},
+		{"d7", "e6"},
+		{"b7", "a8"}, // promotion with capture
+		{"e6", "e5"},
+	};
+	for (auto& t : turns)
+		cb.makeTurn(t.first, t.second);
+	auto end = cb.clone();
+	cout << "halfmove clock: " << cb.halfmoveClock() << endl;
+
+	int undone = 0;
+	while (cb.undoTurn())
+		undone++;
+	bool back = 
+		undone == 8 and cb.state() == start.state() and
+		cb.hash() == start.hash() and cb.turnIndex() == 0 and 
+		cb.halfmoveClock() == 0 and cb.history().empty() and 
+		cb.at("b6") and cb.at("a8") and cb.at("e2") and 
+		cb.perft(2) == start.perft(2);
+	cout << "undo: " << undone << ' ' << back << endl;
+
+	int redone = 0;
+	while (cb.redoTurn())
+		redone++;
+	bool forward = 
+		redone == 8 and cb.state() == end->state() and 
+		cb.turnIndex() == end->turnIndex() and 
+		cb.halfmoveClock() == end->halfmoveClock() and
+		cb.halfmoveClock() == 1 and cb.history().size() == 8 and
+		cb.perft(3) == end->perft(3);
+	cout << "redo: " << redone << ' ' << forward << endl;
+
+	cb.undoTurn();
+	cb.undoTurn();
+	bool passant = cb.state().enPassant() == -1 and cb.canRedo();
+	cb.makeTurn("b7", "b8");
+	passant = passant and !cb.canRedo() and !cb.redoTurn();
+	for (int i = 0; i < 6; i++)
+		cb.undoTurn();
+	Chessboard pushed;
+	pushed.fill(position);
+	pushed.makeTurn("e2", "e4");
+	passant = passant and cb.state().enPassant() == square(5, 3) and
+		cb.state() == pushed.state() and cb.perft(2) == pushed.perft(2);
+	cout << "branch: " << passant << endl;
+
+	return !(back and forward and passant);
+}
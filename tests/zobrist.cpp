@@ -0,0 +1,78 @@
+#include <tartan/chess.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+	using namespace tt;
+	using namespace tt::chess;
+	using C = tt::Piece::Color;
+	using namespace std;
+
+	Chessboard start;
+	start.fill();
+
+	Chessboard cb;
+	cb.fill();
+	std::uint64_t initial = cb.hash();
+	cb.makeTurn("g1", "f3");
+	std::uint64_t knight = cb.hash();
+	cb.makeTurn("g8", "f6");
+	cb.makeTurn("f3", "g1");
+	cb.makeTurn("f6", "g8");
+	bool transposition = 
+		initial == start.hash() and knight != initial and
+		cb.hash() == start.hash();
+	cout << "transposition: " << transposition << endl;
+
+	cb.makeTurn("e2", "e4");
+	State s = start.state();
+	s.makeMove(Move(square(5, 2), square(5, 4), Move::DoublePush));
+	bool passant = s.hash() == cb.hash() and s.enPassant() == -1;
+
+	// en passant tile is hashed only if a pawn can capture onto it
+	Chessboard capture;
+	capture.fromFEN("4k3/8/8/8/3p4/8/4P3/4K3 w - - 0 1");
+	s = capture.state();
+	s.makeMove(Move(square(5, 2), square(5, 4), Move::DoublePush));
+	capture.makeTurn("e2", "e4");
+	State quiet = s;
+	quiet.setEnPassant(-1);
+	passant = passant and s.enPassant() == square(5, 3) and 
+		s.hash() == capture.hash() and quiet.hash() != s.hash();
+
+	Chessboard queens, english;
+	queens.fill();
+	english.fill();
+	queens.makeTurn("d2", "d4");
+	queens.makeTurn("g8", "f6");
+	queens.makeTurn("c2", "c4");
+	english.makeTurn("c2", "c4");
+	english.makeTurn("g8", "f6");
+	english.makeTurn("d2", "d4");
+	passant = passant and queens.hash() == english.hash();
+	cout << "en passant: " << passant << endl;
+
+	Chessboard rooks;
+	rooks.fill("ra8 xe8 rh8 Ra1 Xe1 Rh1");
+	std::uint64_t castling = rooks.hash();
+	rooks.makeTurn("h1", "h2");
+	rooks.makeTurn("h8", "h7");
+	rooks.makeTurn("h2", "h1");
+	rooks.makeTurn("h7", "h8");
+	Chessboard target;
+	target.fill("ra8 xe8 rh8 Ra1 Xe1 Rh1");
+	State lost = target.state();
+	lost.setCastling(State::WhiteQueenside | State::BlackQueenside);
+	bool rights = rooks.hash() != castling and rooks.hash() == lost.hash();
+	cout << "castling rights: " << rights << endl;
+
+	Chessboard side;
+	side.fill();
+	side.setCurrentTurn(C::Black);
+	bool black = side.hash() != initial;
+	side.clear();
+	bool cleared = side.hash() == 0;
+	cout << "side to move: " << black << ' ' << cleared << endl;
+
+	return !(transposition and passant and rights and black and cleared);
+}